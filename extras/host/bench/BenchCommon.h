@@ -0,0 +1,134 @@
+/*
+  BenchCommon.h - Shared helpers for the WebGUI host benchmarks
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_BenchCommon_h
+#define WebGUIHost_BenchCommon_h
+
+#include <WebGUI.h>
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <time.h>
+#include <vector>
+
+#if defined(ESP32)
+  #define WEBGUI_HOST_PERSONALITY "esp32"
+#elif defined(ARDUINO_SAMD_NANO_33_IOT)
+  #define WEBGUI_HOST_PERSONALITY "nano33"
+#else
+  #define WEBGUI_HOST_PERSONALITY "uno_r4"
+#endif
+
+// Built-in element types, used in rotation to build test panels
+enum BenchElementKind {
+    BENCH_BUTTON,
+    BENCH_TOGGLE,
+    BENCH_SLIDER,
+    BENCH_SENSOR,
+    BENCH_TEXTBOX,
+    BENCH_KINDS
+};
+
+inline const char* benchKindName(int kind) {
+    static const char* const NAMES[BENCH_KINDS] = { "Button", "Toggle", "Slider", "SensorStatus", "TextBox" };
+    return NAMES[kind];
+}
+
+// Heap-allocated, laid out in a column like a real panel
+inline GUIElement* benchMakeElement(int kind, int index) {
+    int y = 10 + index * 50;
+    switch (kind) {
+        case BENCH_BUTTON:  return new Button("Button", 10, y);
+        case BENCH_TOGGLE:  return new Toggle("Toggle", 10, y);
+        case BENCH_SLIDER:  return new Slider("Slider", 10, y, 0, 1000, 500);
+        case BENCH_SENSOR:  return new SensorStatus("Sensor", 10, y);
+        default:            return new TextBox("Text", 10, y, 200, "Type here");
+    }
+}
+
+// Duration samples with exact percentiles
+class BenchSamples {
+  public:
+    void add(uint64_t value) { values.push_back(value); sorted = false; }
+    size_t size() const { return values.size(); }
+
+    uint64_t percentile(double fraction) {
+        if (values.empty()) return 0;
+        if (!sorted) {
+            std::sort(values.begin(), values.end());
+            sorted = true;
+        }
+        size_t index = (size_t)(fraction * (values.size() - 1) + 0.5);
+        return values[index];
+    }
+    uint64_t max() { return percentile(1.0); }
+
+  private:
+    std::vector<uint64_t> values;
+    bool sorted = true;
+};
+
+// CPU time used by this thread in us. Unlike micros() it leaves out time
+// the machine spent running something else, so limits on it hold on a
+// busy CI runner.
+inline uint64_t benchThreadCpuMicros() {
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+// "10,50,200" -> {10, 50, 200}
+inline std::vector<int> benchParseList(const char* text) {
+    std::vector<int> list;
+    while (text && *text) {
+        char* end;
+        long value = strtol(text, &end, 10);
+        if (end == text) break;
+        list.push_back((int)value);
+        text = *end == ',' ? end + 1 : end;
+    }
+    return list;
+}
+
+inline std::string benchGet(const std::string& path) {
+    return "GET " + path + " HTTP/1.1\r\nHost: webgui\r\n\r\n";
+}
+
+// A recorded corpus (extras/host/corpus/*.http): raw requests back to back,
+// each ending at its blank line. Empty if the file can't be read.
+inline std::vector<std::string> benchLoadCorpus(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<std::string> requests;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find("\r\n\r\n", start);
+        end = end == std::string::npos ? text.size() : end + 4;
+        requests.push_back(text.substr(start, end - start));
+        start = end;
+    }
+    return requests;
+}
+
+// Names of the *.http corpora in a directory, sorted
+inline std::vector<std::string> benchListCorpora(const std::string& directory) {
+    std::vector<std::string> names;
+    if (DIR* dir = opendir(directory.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.size() > 5 && name.compare(name.size() - 5, 5, ".http") == 0) {
+                names.push_back(name);
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+  link.cpp - Page, poll and update timings over emulated Wi-Fi links
+
+  Runs on the virtual clock with each client on an emulated link (HostLink),
+  from a wired LAN down to a weak, lossy signal. One tab loads the page,
+  then polls /get and sends /set, each request after the previous one has
+  arrived. Reported per link and route:
+    client ms   from the browser opening the connection to the last
+                response byte arriving, p50/p99
+    loop ms     how long update() held the sketch's loop() while serving
+                it: waiting for request bytes and for the send window, p50/p99
+    kB/s        response bytes per second of client time
+
+  Times are link time only: the library's own CPU time counts as zero here
+  (load_bench and render_bench measure that). Loss is seeded, so every run
+  prints the same numbers and a change in them comes from the library.
+
+  usage: link_bench [--requests 200] [--quick]
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "BenchCommon.h"
+
+static const uint16_t BENCH_PORT = 8083;
+static const int BENCH_ELEMENTS = 20;
+static const unsigned long LOOP_MICROS = 100;    // A sketch's loop() between update() calls
+
+struct LinkProfile {
+    const char* name;
+    unsigned long latencyMicros;
+    unsigned long bytesPerSecond;
+    float loss;
+};
+
+static const LinkProfile PROFILES[] = {
+    { "lan",        500, 5000000, 0.00f },
+    { "wifi_good", 2000, 1000000, 0.00f },
+    { "wifi_fair", 8000,  200000, 0.01f },
+    { "wifi_weak", 30000,  40000, 0.05f },
+};
+
+struct RouteResults {
+    BenchSamples client;
+    BenchSamples loop;
+    uint64_t bytes = 0;
+    uint64_t clientMicros = 0;
+};
+
+// One request over the link; true if it was answered with 200
+static bool runRequest(WebGUI& gui, const LinkProfile& profile, uint32_t seed, const std::string& path,
+                       RouteResults& results) {
+    HostLink link;
+    link.latencyMicros = profile.latencyMicros;
+    link.bytesPerSecond = profile.bytesPerSecond;
+    link.loss = profile.loss;
+    link.seed = seed;
+    auto connection = WebGUIHost::connect(BENCH_PORT, benchGet(path), link);
+
+    unsigned long inUpdate = 0;
+    while (!connection->closed) {
+        unsigned long start = micros();
+        gui.update();
+        inUpdate += micros() - start;
+        hostAdvanceMicros(LOOP_MICROS);
+    }
+    // The browser reads on after the device has moved on
+    while ((long)(micros() - connection->deliveredMicros) < 0) {
+        hostAdvanceMicros(LOOP_MICROS);
+    }
+
+    unsigned long clientMicros = connection->deliveredMicros - connection->openedMicros;
+    results.client.add(clientMicros);
+    results.loop.add(inUpdate);
+    results.bytes += connection->tx.size();
+    results.clientMicros += clientMicros;
+    return WebGUIHost::responseStatus(*connection) == 200;
+}
+
+static void printRow(const char* link, const char* route, RouteResults& results) {
+    printf("%-10s %-5s %9.1f %9.1f %9.1f %9.1f %8.1f\n", link, route,
+           results.client.percentile(0.5) / 1000.0, results.client.percentile(0.99) / 1000.0,
+           results.loop.percentile(0.5) / 1000.0, results.loop.percentile(0.99) / 1000.0,
+           results.clientMicros ? results.bytes * 1000.0 / results.clientMicros : 0.0);
+}
+
+int main(int argc, char** argv) {
+    int requests = 200;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--requests" && i + 1 < argc) {
+            requests = atoi(argv[++i]);
+        } else if (arg == "--quick") {
+            requests = 20;
+        } else {
+            fprintf(stderr, "usage: %s [--requests 200] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Serial.setQuiet(true);
+    hostUseVirtualClock();
+    WebGUI gui(BENCH_PORT);
+    std::vector<GUIElement*> panel;
+    for (int i = 0; i < BENCH_ELEMENTS; i++) {
+        panel.push_back(benchMakeElement(i % BENCH_KINDS, i));
+        gui.addElement(panel.back());
+    }
+    gui.begin();
+    std::string setPath = std::string("/set?") + panel[BENCH_SLIDER]->getIDCStr() + "=";
+
+    printf("WebGUI link benchmark (%s personality, %d elements, %d requests per route)\n\n",
+           WEBGUI_HOST_PERSONALITY, BENCH_ELEMENTS, requests);
+    printf("%-10s %-5s %9s %9s %9s %9s %8s\n", "link", "route",
+           "client50", "client99", "loop50", "loop99", "kB/s");
+
+    unsigned long failed = 0;
+    for (const LinkProfile& profile : PROFILES) {
+        RouteResults page, poll, set;
+        uint32_t seed = 1;
+        int pageLoads = requests / 10 > 0 ? requests / 10 : 1;
+        for (int i = 0; i < pageLoads; i++) {
+            if (!runRequest(gui, profile, seed++, "/", page)) failed++;
+        }
+        for (int i = 0; i < requests; i++) {
+            if (!runRequest(gui, profile, seed++, "/get", poll)) failed++;
+            if (!runRequest(gui, profile, seed++, setPath + std::to_string(i % 1000), set)) failed++;
+        }
+        printRow(profile.name, "page", page);
+        printRow(profile.name, "get", poll);
+        printRow(profile.name, "set", set);
+    }
+
+    for (GUIElement* element : panel) delete element;
+    if (failed) {
+        printf("\nFAIL: %lu request(s) not answered with 200\n", failed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+  load.cpp - Simulated multi-tab load benchmark for the WebGUI host build
+
+  Simulates N browser tabs against panels of different sizes. Every tab
+  loads the page once, then does what the page's JavaScript does: poll /get
+  every 100 ms and, while a slider is dragged, send a burst of /set calls.
+  The simulation steps a 1 ms clock; requests due in the same step queue up
+  behind each other exactly as they would in the single-threaded server.
+
+  Reported per run:
+    req/s      requests served per second of host CPU time spent in update()
+    wire kB/s  response bytes the tabs pull per simulated second
+    p50/p99    request latency in us, from queueing to response, per route
+    allocs     heap allocations per request made by the library while
+               serving it (WEBGUI_ALLOC_STATS), per route
+
+  usage: load_bench [--tabs 1,4,16] [--elements 10,50,200] [--seconds 10]
+                    [--quick]
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "BenchCommon.h"
+#include <deque>
+#include <memory>
+
+static const uint16_t BENCH_PORT = 8080;
+static const unsigned long POLL_INTERVAL_MS = 100;    // setInterval(updateSensorDisplays, 100)
+static const unsigned long DRAG_INTERVAL_MS = 2000;   // A tab starts a slider drag this often
+static const int DRAG_REQUESTS = 5;                   // /set calls per drag
+static const unsigned long DRAG_SPACING_MS = 150;     // Slider debounce (100 ms) plus hand movement
+static const size_t RESPONSE_RESERVE = 256 * 1024;    // Keeps shim buffer growth out of the counts
+
+struct Tab {
+    unsigned long nextPoll;
+    unsigned long nextDrag;
+    int dragRemaining;
+    unsigned long nextDragStep;
+    int dragValue;
+};
+
+struct InFlight {
+    std::shared_ptr<HostConnection> connection;
+    WebGUIRoute route;
+    unsigned long queuedAt;
+};
+
+struct RouteResults {
+    BenchSamples latency;
+    uint64_t bytesOut = 0;
+};
+
+static void queueRequest(std::deque<InFlight>& inFlight, WebGUIRoute route, const std::string& path) {
+    auto connection = WebGUIHost::connect(BENCH_PORT, benchGet(path));
+    connection->tx.reserve(RESPONSE_RESERVE);
+    inFlight.push_back({ connection, route, micros() });
+}
+
+static double allocsPerRequest(WebGUIAllocCategory category) {
+    WebGUIAllocStats stats = getAllocStats(category);
+    return stats.calls ? (double)stats.allocations / stats.calls : 0.0;
+}
+
+static void runScenario(int elementCount, int tabCount, unsigned long durationMs) {
+    WebGUI gui(BENCH_PORT);
+    std::vector<GUIElement*> panel;
+    std::vector<Slider*> sliders;
+    std::vector<SensorStatus*> sensors;
+    for (int i = 0; i < elementCount; i++) {
+        int kind = i % BENCH_KINDS;
+        GUIElement* element = benchMakeElement(kind, i);
+        panel.push_back(element);
+        if (kind == BENCH_SLIDER) sliders.push_back(static_cast<Slider*>(element));
+        if (kind == BENCH_SENSOR) sensors.push_back(static_cast<SensorStatus*>(element));
+        gui.addElement(element);
+    }
+    gui.begin();
+    resetAllocStats();
+
+    // Tabs open over the first second and start their drags staggered
+    std::vector<Tab> tabs(tabCount);
+    std::deque<InFlight> inFlight;
+    for (int t = 0; t < tabCount; t++) {
+        unsigned long opened = (unsigned long)t * 1000 / tabCount;
+        tabs[t] = { opened, opened + DRAG_INTERVAL_MS / 2 + (unsigned long)t * 37 % DRAG_INTERVAL_MS, 0, 0, 0 };
+        queueRequest(inFlight, WEBGUI_ROUTE_PAGE, "/");
+    }
+
+    RouteResults results[WEBGUI_ROUTES];
+    uint64_t serviceMicros = 0;
+    unsigned long requests = 0;
+
+    for (unsigned long now = 0; now < durationMs; now++) {
+        // The sketch keeps its sensor readings current
+        if (now % 10 == 0) {
+            for (size_t i = 0; i < sensors.size(); i++) {
+                sensors[i]->setValue(20.0f + (float)((now / 10 + i) % 100) / 10.0f, 1);
+            }
+        }
+
+        for (int t = 0; t < tabCount; t++) {
+            Tab& tab = tabs[t];
+            if (now >= tab.nextPoll) {
+                queueRequest(inFlight, WEBGUI_ROUTE_GET, "/get");
+                tab.nextPoll += POLL_INTERVAL_MS;
+            }
+            if (!sliders.empty() && now >= tab.nextDrag) {
+                tab.dragRemaining = DRAG_REQUESTS;
+                tab.nextDragStep = now;
+                tab.nextDrag += DRAG_INTERVAL_MS;
+            }
+            if (tab.dragRemaining > 0 && now >= tab.nextDragStep) {
+                Slider* slider = sliders[t % sliders.size()];
+                tab.dragValue = (tab.dragValue + 97) % 1000;
+                queueRequest(inFlight, WEBGUI_ROUTE_SET,
+                             std::string("/set?") + slider->getIDCStr() + "=" + std::to_string(tab.dragValue));
+                tab.dragRemaining--;
+                tab.nextDragStep += DRAG_SPACING_MS;
+            }
+        }
+
+        // One connection per update(), in arrival order
+        while (!inFlight.empty()) {
+            unsigned long start = micros();
+            gui.update();
+            unsigned long end = micros();
+            serviceMicros += end - start;
+
+            InFlight& request = inFlight.front();
+            RouteResults& route = results[request.route];
+            route.latency.add(end - request.queuedAt);
+            route.bytesOut += request.connection->tx.size();
+            requests++;
+            inFlight.pop_front();
+        }
+    }
+
+    uint64_t bytesOut = 0;
+    for (const RouteResults& route : results) bytesOut += route.bytesOut;
+    double seconds = durationMs / 1000.0;
+
+    printf("%8d %5d %9lu %9.0f %9.1f   %6llu/%-7llu %6llu/%-7llu %6llu/%-7llu   %5.1f %5.1f %5.1f\n",
+           elementCount, tabCount, requests,
+           serviceMicros ? requests * 1e6 / serviceMicros : 0.0,
+           bytesOut / 1024.0 / seconds,
+           (unsigned long long)results[WEBGUI_ROUTE_PAGE].latency.percentile(0.5),
+           (unsigned long long)results[WEBGUI_ROUTE_PAGE].latency.percentile(0.99),
+           (unsigned long long)results[WEBGUI_ROUTE_GET].latency.percentile(0.5),
+           (unsigned long long)results[WEBGUI_ROUTE_GET].latency.percentile(0.99),
+           (unsigned long long)results[WEBGUI_ROUTE_SET].latency.percentile(0.5),
+           (unsigned long long)results[WEBGUI_ROUTE_SET].latency.percentile(0.99),
+           allocsPerRequest(WEBGUI_ALLOC_PAGE), allocsPerRequest(WEBGUI_ALLOC_GET),
+           allocsPerRequest(WEBGUI_ALLOC_SET));
+
+    for (GUIElement* element : panel) delete element;
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> tabCounts = { 1, 4, 16 };
+    std::vector<int> elementCounts = { 10, 50, 200 };
+    unsigned long durationMs = 10000;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            tabCounts = { 2 };
+            elementCounts = { 10 };
+            durationMs = 3000;
+        } else if (arg == "--tabs" && i + 1 < argc) {
+            tabCounts = benchParseList(argv[++i]);
+        } else if (arg == "--elements" && i + 1 < argc) {
+            elementCounts = benchParseList(argv[++i]);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            durationMs = strtoul(argv[++i], nullptr, 10) * 1000;
+        } else {
+            fprintf(stderr, "usage: %s [--tabs 1,4,16] [--elements 10,50,200] [--seconds 10] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Serial.setQuiet(true);
+    printf("WebGUI load benchmark (%s personality, %lu s simulated per run)\n\n",
+           WEBGUI_HOST_PERSONALITY, durationMs / 1000);
+    printf("elements  tabs  requests     req/s  wire kB/s   page p50/p99 us  get p50/p99 us   set p50/p99 us   "
+           "allocs page/get/set\n");
+    for (int elements : elementCounts) {
+        for (int tabs : tabCounts) {
+            runScenario(elements, tabs, durationMs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+  parse.cpp - Request throughput regression benchmark for the WebGUI host build
+
+  Replays each recorded corpus (extras/host/corpus/*.http) against a panel
+  of one element of each kind, one request per update() as a browser sends
+  them, and reports per corpus:
+    req/s      requests per second of host CPU time spent in update()
+    p50/p99    update() wall time per request in us
+    cpu p99    update() thread CPU time per request in us
+    allocs     heap allocations per request inside update()
+               (WEBGUI_ALLOC_STATS)
+
+  The recorded requests are all valid, so any status but 200 fails the
+  run: a faster parser still has to parse. With --thresholds each corpus
+  is also held to the limits in that file (bench/parse_thresholds.txt),
+  and a corpus over its limit fails the run. The time limit applies to
+  CPU time rather than wall time, so another process taking the core
+  mid-request doesn't fail the run.
+
+  usage: parse_bench --corpus dir [--thresholds file] [--rounds 50] [--quick]
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "BenchCommon.h"
+#include <sstream>
+
+static const uint16_t BENCH_PORT = 8082;
+
+struct Threshold {
+    std::string corpus;
+    std::string personality;
+    double maxCpuP99Micros;
+    double maxAllocs;
+};
+
+// "<corpus> <personality or *> <max cpu p99 us> <max allocs/request>" per line
+static std::vector<Threshold> loadThresholds(const std::string& path) {
+    std::vector<Threshold> thresholds;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        Threshold threshold;
+        if (fields >> threshold.corpus >> threshold.personality >> threshold.maxCpuP99Micros >> threshold.maxAllocs) {
+            thresholds.push_back(threshold);
+        }
+    }
+    return thresholds;
+}
+
+// Returns false if a request failed or a threshold was exceeded
+static bool replayCorpus(WebGUI& gui, const std::string& directory, const std::string& name,
+                         int rounds, const std::vector<Threshold>& thresholds) {
+    std::vector<std::string> requests = benchLoadCorpus(directory + "/" + name);
+    if (requests.empty()) {
+        printf("%-14s cannot read %s/%s\n", name.c_str(), directory.c_str(), name.c_str());
+        return false;
+    }
+
+    BenchSamples samples;
+    BenchSamples cpuSamples;
+    uint64_t serviceMicros = 0;
+    unsigned long failed = 0;
+    resetAllocStats();
+    for (int round = 0; round < rounds; round++) {
+        for (const std::string& request : requests) {
+            auto connection = WebGUIHost::connect(BENCH_PORT, request);
+            connection->tx.reserve(64 * 1024);   // Keeps shim buffer growth out of the counts
+            unsigned long start = micros();
+            uint64_t cpuStart = benchThreadCpuMicros();
+            gui.update();
+            uint64_t cpuElapsed = benchThreadCpuMicros() - cpuStart;
+            samples.add(micros() - start);
+            cpuSamples.add(cpuElapsed);
+            serviceMicros += cpuElapsed;
+            if (WebGUIHost::responseStatus(*connection) != 200) {
+                failed++;
+            }
+        }
+    }
+
+    unsigned long total = (unsigned long)samples.size();
+    double allocs = (double)getAllocStats(WEBGUI_ALLOC_UPDATE).allocations / total;
+    uint64_t cpuP99 = cpuSamples.percentile(0.99);
+    printf("%-14s %8zu %9.0f %7llu %7llu %7llu %8.2f",
+           name.c_str(), requests.size(), serviceMicros ? total * 1e6 / serviceMicros : 0.0,
+           (unsigned long long)samples.percentile(0.5), (unsigned long long)samples.percentile(0.99),
+           (unsigned long long)cpuP99, allocs);
+
+    bool passed = failed == 0;
+    if (failed) {
+        printf("   FAIL: %lu request(s) not answered with 200", failed);
+    }
+    // A line for this personality overrides a "*" line
+    const Threshold* limit = nullptr;
+    for (const Threshold& threshold : thresholds) {
+        if (threshold.corpus == name && threshold.personality == WEBGUI_HOST_PERSONALITY) {
+            limit = &threshold;
+        } else if (threshold.corpus == name && threshold.personality == "*" && !limit) {
+            limit = &threshold;
+        }
+    }
+    if (limit && cpuP99 > limit->maxCpuP99Micros) {
+        printf("   FAIL: cpu p99 over %.0f us", limit->maxCpuP99Micros);
+        passed = false;
+    }
+    if (limit && allocs > limit->maxAllocs) {
+        printf("   FAIL: allocs over %.2f", limit->maxAllocs);
+        passed = false;
+    }
+    printf("\n");
+    return passed;
+}
+
+int main(int argc, char** argv) {
+    std::string corpus;
+    std::string thresholdsPath;
+    int rounds = 50;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--corpus" && i + 1 < argc) {
+            corpus = argv[++i];
+        } else if (arg == "--thresholds" && i + 1 < argc) {
+            thresholdsPath = argv[++i];
+        } else if (arg == "--rounds" && i + 1 < argc) {
+            rounds = atoi(argv[++i]);
+        } else if (arg == "--quick") {
+            rounds = 5;
+        } else {
+            fprintf(stderr, "usage: %s --corpus dir [--thresholds file] [--rounds 50] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (corpus.empty()) {
+        fprintf(stderr, "usage: %s --corpus dir [--thresholds file] [--rounds 50] [--quick]\n", argv[0]);
+        return 2;
+    }
+
+    // Element IDs element0..element4 in kind order, as the corpora expect
+    Serial.setQuiet(true);
+    WebGUI gui(BENCH_PORT);
+    std::vector<GUIElement*> panel;
+    for (int kind = 0; kind < BENCH_KINDS; kind++) {
+        panel.push_back(benchMakeElement(kind, kind));
+        gui.addElement(panel.back());
+    }
+    gui.begin();
+
+    std::vector<Threshold> thresholds;
+    if (!thresholdsPath.empty()) {
+        thresholds = loadThresholds(thresholdsPath);
+    }
+
+    printf("WebGUI parse benchmark (%s personality, %d rounds per corpus)\n\n", WEBGUI_HOST_PERSONALITY, rounds);
+    printf("%-14s %8s %9s %7s %7s %7s %8s\n", "corpus", "requests", "req/s", "p50 us", "p99 us", "cpu p99", "allocs");
+    std::vector<std::string> names = benchListCorpora(corpus);
+    bool passed = !names.empty();
+    for (const std::string& name : names) {
+        passed = replayCorpus(gui, corpus, name, rounds, thresholds) && passed;
+    }
+
+    for (GUIElement* element : panel) delete element;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+/*
+  render.cpp - Per-element render microbenchmarks for the WebGUI host build
+
+  Times each built-in element's output functions in isolation: the String
+  builders (generateHTML(), generateJS(), getValue()) and the streaming
+  versions the server actually uses (streamHTML(), streamJS(),
+  streamValue()). Then times full page and /get responses for panels of
+  increasing size, to show how cost grows with element count.
+
+  Reported per operation:
+    ns/op      host wall time, averaged over enough calls to fill ~20 ms
+    bytes      output size of one call
+    allocs/op  heap allocations per call (WEBGUI_ALLOC_STATS)
+
+  usage: render_bench [--elements 10,50,200] [--quick]
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "BenchCommon.h"
+#include <chrono>
+#include <functional>
+
+static const uint16_t BENCH_PORT = 8081;
+static const int COUNT_ITERATIONS = 100;   // Calls made inside the allocation scope
+
+static double targetSeconds = 0.02;
+
+// Discards output, counting bytes
+class CountingPrint : public Print {
+  public:
+    size_t write(uint8_t) override { bytes++; return 1; }
+    size_t write(const uint8_t*, size_t size) override { bytes += size; return size; }
+    using Print::write;
+    size_t bytes = 0;
+};
+
+struct OpResult {
+    double nanos;
+    size_t bytes;
+    double allocs;
+};
+
+// op() returns the bytes it produced. Allocations are read from the given
+// category; openScope counts everything op() does, otherwise only what
+// the library's own scopes (page, /get handling) see.
+static OpResult measure(const std::function<size_t()>& op,
+                        WebGUIAllocCategory category = WEBGUI_ALLOC_PAGE, bool openScope = true) {
+    OpResult result;
+    result.bytes = op();   // Warm up and size the output
+
+    typedef std::chrono::steady_clock Clock;
+    long iterations = 1;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        for (long i = 0; i < iterations; i++) op();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (elapsed >= targetSeconds || iterations >= (1L << 26)) {
+            result.nanos = elapsed * 1e9 / iterations;
+            break;
+        }
+        iterations = elapsed > 0 ? (long)(iterations * targetSeconds / elapsed * 1.1) + 1 : iterations * 10;
+    }
+
+    // Counted separately so the accounting doesn't skew the timing
+    resetAllocStats();
+    if (openScope) {
+        WebGUIAllocScope scope(category);
+        for (int i = 0; i < COUNT_ITERATIONS; i++) op();
+    } else {
+        for (int i = 0; i < COUNT_ITERATIONS; i++) op();
+    }
+    result.allocs = (double)getAllocStats(category).allocations / COUNT_ITERATIONS;
+    return result;
+}
+
+static void report(const char* subject, const char* operation, const OpResult& result, int perElement = 0) {
+    printf("%-14s %-14s %12.0f %10zu %10.1f", subject, operation, result.nanos, result.bytes, result.allocs);
+    if (perElement > 0) {
+        printf(" %12.0f", result.nanos / perElement);
+    }
+    printf("\n");
+}
+
+static void benchElements() {
+    printf("%-14s %-14s %12s %10s %10s\n", "element", "operation", "ns/op", "bytes", "allocs/op");
+    for (int kind = 0; kind < BENCH_KINDS; kind++) {
+        GUIElement* element = benchMakeElement(kind, 0);
+        const char* name = benchKindName(kind);
+        CountingPrint sink;
+
+        report(name, "generateHTML", measure([&] { return (size_t)element->generateHTML().length(); }));
+        report(name, "streamHTML", measure([&] { sink.bytes = 0; element->streamHTML(sink); return sink.bytes; }));
+        report(name, "generateJS", measure([&] { return (size_t)element->generateJS().length(); }));
+        report(name, "streamJS", measure([&] { sink.bytes = 0; element->streamJS(sink); return sink.bytes; }));
+        report(name, "getValue", measure([&] { return (size_t)element->getValue().length(); }));
+        report(name, "streamValue", measure([&] { sink.bytes = 0; element->streamValue(sink); return sink.bytes; }));
+        delete element;
+    }
+}
+
+// Page and /get through the request path, as a browser would see them
+static void benchPanels(const std::vector<int>& elementCounts) {
+    printf("\n%-14s %-14s %12s %10s %10s %12s\n", "panel", "response", "ns/op", "bytes", "allocs/op", "ns/element");
+    for (int count : elementCounts) {
+        WebGUI gui(BENCH_PORT);
+        std::vector<GUIElement*> panel;
+        for (int i = 0; i < count; i++) {
+            panel.push_back(benchMakeElement(i % BENCH_KINDS, i));
+            gui.addElement(panel.back());
+        }
+        gui.begin();
+
+        char subject[32];
+        snprintf(subject, sizeof(subject), "%d elements", count);
+        const char* paths[] = { "/", "/get" };
+        const char* names[] = { "page", "get" };
+        const WebGUIAllocCategory categories[] = { WEBGUI_ALLOC_PAGE, WEBGUI_ALLOC_GET };
+        for (int p = 0; p < 2; p++) {
+            std::string request = benchGet(paths[p]);
+            size_t responseSize = 0;
+            OpResult result = measure([&] {
+                // Sized up front so buffer growth in the shim isn't counted
+                auto connection = WebGUIHost::connect(BENCH_PORT, request);
+                connection->tx.reserve(responseSize);
+                gui.update();
+                responseSize = connection->tx.size();
+                return responseSize;
+            }, categories[p], false);
+            report(subject, names[p], result, count);
+        }
+        for (GUIElement* element : panel) delete element;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> elementCounts = { 10, 50, 200 };
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            elementCounts = { 10 };
+            targetSeconds = 0.001;
+        } else if (arg == "--elements" && i + 1 < argc) {
+            elementCounts = benchParseList(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [--elements 10,50,200] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Serial.setQuiet(true);
+    printf("WebGUI render benchmark (%s personality)\n\n", WEBGUI_HOST_PERSONALITY);
+    benchElements();
+    benchPanels(elementCounts);
+    return 0;
+}
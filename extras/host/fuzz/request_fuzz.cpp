@@ -0,0 +1,290 @@
+/*
+  request_fuzz.cpp - Fuzzes the WebGUI request parser on the host
+
+  Feeds hostile input to the hand-rolled parsing in processClient() and
+  handleSetRequest(), one connection per input, and checks after each one:
+    - update() returned, even for a peer that stalls mid-request
+    - the connection was closed
+    - any response starts with an HTTP/1.1 status line
+    - element state is still valid (slider within its range)
+    - the server still answers a normal /get afterwards (checked regularly)
+  Memory errors are caught by AddressSanitizer and UBSan when the build
+  enables them (WEBGUI_HOST_SANITIZE), and heap use inside update() by the
+  zero-heap assertion in that personality.
+
+  Two drivers share the checks. With WEBGUI_HOST_LIBFUZZER (clang only)
+  this is a libFuzzer target. Otherwise main() mutates the recorded
+  corpora and generates the known trouble cases itself: oversized request
+  lines, missing or bare line endings, huge query strings and headers, and
+  malformed percent-encoding, from a fixed seed so failures reproduce.
+
+  usage: request_fuzz [--iterations 20000] [--seed 1] [--corpus dir] [file...]
+
+  Files given on the command line are run as single inputs, to replay a
+  failure. A failing input is written to request_fuzz-failure.http.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "../bench/BenchCommon.h"
+#include <map>
+#include <random>
+
+static const int GET_CHECK_INTERVAL = 64;   // Inputs between /get sanity checks
+
+Button button("Press", 10, 10);
+Toggle toggle("Power", 10, 60);
+Slider slider("Speed", 10, 110, 0, 100, 50);
+SensorStatus sensor("Temperature", 10, 160);
+TextBox textBox("Name", 10, 210, 200, "Type here");
+
+static std::map<int, unsigned long> statusCounts;
+static unsigned long inputs = 0;
+
+static void fail(const char* what, const std::string& input) {
+    fprintf(stderr, "request_fuzz: %s (input of %zu bytes saved to request_fuzz-failure.http)\n",
+            what, input.size());
+    std::ofstream("request_fuzz-failure.http", std::ios::binary).write(input.data(), input.size());
+    abort();
+}
+
+static void setup() {
+    static bool ready = false;
+    if (ready) return;
+    ready = true;
+    Serial.setQuiet(true);
+    GUI.addElement(&button);
+    GUI.addElement(&toggle);
+    GUI.addElement(&slider);
+    GUI.addElement(&sensor);
+    GUI.addElement(&textBox);
+    GUI.begin();
+}
+
+// A stalled peer keeps the connection open after its bytes, so only the
+// request timeout ends the read
+static void runOne(const std::string& input, bool stalled = false) {
+    auto connection = WebGUIHost::connect(80, input);
+    connection->peerDone = !stalled;
+    GUI.update();
+    inputs++;
+
+    if (WebGUIHost::pending(80) != 0) {
+        fail("connection not accepted", input);
+    }
+    if (!connection->closed) {
+        fail("connection left open", input);
+    }
+    if (!connection->tx.empty() && connection->tx.compare(0, 9, "HTTP/1.1 ") != 0) {
+        fail("response without a status line", input);
+    }
+    statusCounts[WebGUIHost::responseStatus(*connection)]++;
+    if (slider.getIntValue() < slider.getMinValue() || slider.getIntValue() > slider.getMaxValue()) {
+        fail("slider value out of range", input);
+    }
+
+    if (inputs % GET_CHECK_INTERVAL == 0) {
+        auto check = WebGUIHost::connect(80, benchGet("/get"));
+        GUI.update();
+        std::string body = WebGUIHost::responseBody(*check);
+        if (WebGUIHost::responseStatus(*check) != 200 || body.empty() || body[0] != '{') {
+            fail("server stopped answering /get after this input", input);
+        }
+    }
+}
+
+#ifdef WEBGUI_HOST_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    setup();
+    runOne(std::string((const char*)data, size));
+    return 0;
+}
+
+#else
+
+static const std::string TOKENS[] = {
+    "%", "%%", "%0", "%G1", "%zz", "%00", "%FF", "+", "&", "=", "&&", "==", "?",
+    "\r", "\n", "\r\n", "\r\n\r\n", std::string("\0", 1), " ", "GET ", "/set?", "/get",
+    "element2=", "element4=", "HTTP/1.1",
+};
+
+class Mutator {
+  public:
+    explicit Mutator(uint32_t seed) : random(seed) {}
+
+    size_t below(size_t limit) { return limit ? random() % limit : 0; }
+    bool chance(int percent) { return (int)below(100) < percent; }
+
+    const std::string& token() { return TOKENS[below(sizeof(TOKENS) / sizeof(TOKENS[0]))]; }
+
+    std::string bytes(size_t count) {
+        std::string text(count, '\0');
+        for (char& c : text) c = (char)below(256);
+        return text;
+    }
+
+    // A few random edits: flips, inserted tokens, cuts and repeats
+    std::string mutate(std::string input) {
+        int edits = 1 + (int)below(8);
+        for (int i = 0; i < edits; i++) {
+            size_t at = below(input.size() + 1);
+            switch (below(6)) {
+                case 0:
+                    if (!input.empty()) input[below(input.size())] ^= (char)(1 << below(8));
+                    break;
+                case 1:
+                    input.insert(at, token());
+                    break;
+                case 2:
+                    input.insert(at, bytes(1 + below(16)));
+                    break;
+                case 3:
+                    input.erase(at, below(32));
+                    break;
+                case 4:
+                    if (at < input.size()) {
+                        std::string chunk = input.substr(at, 1 + below(64));
+                        input.insert(at, chunk);
+                    }
+                    break;
+                default:
+                    input.resize(at);
+                    break;
+            }
+        }
+        return input;
+    }
+
+    // The cases the parser is most likely to get wrong
+    std::string generate() {
+        switch (below(7)) {
+            case 0: {
+                // Request line near and past WEBGUI_MAX_REQUEST_LINE
+                size_t length = WEBGUI_MAX_REQUEST_LINE - 16 + below(WEBGUI_MAX_REQUEST_LINE * 2);
+                return "GET /set?element4=" + std::string(length, 'a' + below(26)) + " HTTP/1.1\r\n\r\n";
+            }
+            case 1: {
+                // Huge query: many parameters, most for unknown elements
+                std::string query = "GET /set?";
+                size_t count = below(400);
+                for (size_t i = 0; i < count; i++) {
+                    query += (i ? "&" : "") + std::string("element") + std::to_string(below(8)) + "=" +
+                             std::to_string((long)below(1u << 31) - (1L << 30));
+                }
+                return query + " HTTP/1.1\r\n\r\n";
+            }
+            case 2: {
+                // Malformed percent-encoding in names and values
+                std::string query = "GET /set?";
+                int count = 1 + (int)below(6);
+                for (int i = 0; i < count; i++) {
+                    query += (i ? "&" : "") + std::string(chance(50) ? "element4" : "%65lement2") + "=" +
+                             token() + token() + token();
+                }
+                return query + (chance(50) ? " HTTP/1.1\r\n\r\n" : "");
+            }
+            case 3: {
+                // Bare LF, bare CR or no line endings at all
+                std::string request = "GET /get HTTP/1.1\r\nHost: webgui\r\nAccept: */*\r\n\r\n";
+                std::string from = "\r\n";
+                std::string to = below(3) == 0 ? "\n" : (chance(50) ? "\r" : "");
+                for (size_t at = request.find(from); at != std::string::npos; at = request.find(from, at + to.size())) {
+                    request.replace(at, from.size(), to);
+                }
+                return request;
+            }
+            case 4: {
+                // Headers far larger than any buffer
+                std::string request = "GET / HTTP/1.1\r\n";
+                if (chance(50)) {
+                    request += "X-Long: " + std::string(8192 + below(65536), 'x') + "\r\n";
+                } else {
+                    for (size_t i = below(2000); i > 0; i--) request += "X-Many: 1\r\n";
+                }
+                return request + "\r\n";
+            }
+            case 5:
+                return bytes(below(2048));
+            default:
+                return "\r\n";
+        }
+    }
+
+  private:
+    std::mt19937 random;
+};
+
+static std::vector<std::string> loadSeeds(const std::string& directory) {
+    std::vector<std::string> seeds;
+    for (const std::string& name : benchListCorpora(directory)) {
+        for (const std::string& request : benchLoadCorpus(directory + "/" + name)) {
+            seeds.push_back(request);
+        }
+    }
+    return seeds;
+}
+
+int main(int argc, char** argv) {
+    unsigned long iterations = 20000;
+    uint32_t seed = 1;
+    std::string corpus;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--corpus" && i + 1 < argc) {
+            corpus = argv[++i];
+        } else if (arg.compare(0, 2, "--") != 0) {
+            files.push_back(arg);
+        } else {
+            fprintf(stderr, "usage: %s [--iterations 20000] [--seed 1] [--corpus dir] [file...]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup();
+    if (!files.empty()) {
+        for (const std::string& path : files) {
+            std::ifstream file(path, std::ios::binary);
+            runOne(std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()));
+        }
+        printf("%zu input(s) passed\n", files.size());
+        return 0;
+    }
+
+    std::vector<std::string> seeds = loadSeeds(corpus);
+    if (seeds.empty()) {
+        seeds.push_back(benchGet("/"));
+        seeds.push_back(benchGet("/get"));
+        seeds.push_back(benchGet("/set?element2=42&element4=hello+world"));
+    }
+
+    Mutator mutator(seed);
+    for (const std::string& input : seeds) {
+        runOne(input);
+    }
+    for (unsigned long i = 0; i < iterations; i++) {
+        std::string input = mutator.chance(60) ? mutator.mutate(seeds[mutator.below(seeds.size())])
+                                               : mutator.generate();
+        // Stalls cost a request timeout each, so they're kept rare
+        bool stalled = mutator.below(500) == 0;
+        if (stalled) {
+            input.resize(mutator.below(input.size() + 1));
+        }
+        runOne(input, stalled);
+    }
+
+    printf("WebGUI request fuzz (%s personality): %lu inputs from %zu seeds, seed %u\n",
+           WEBGUI_HOST_PERSONALITY, inputs, seeds.size(), seed);
+    for (const auto& status : statusCounts) {
+        printf("  status %3d: %lu\n", status.first, status.second);
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,627 @@
+/*
+  Gateway.cpp - epoll front end that serves one WebGUI to many clients
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "Gateway.h"
+#include <WebGUI.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+#include <unordered_map>
+
+static const size_t MAX_REQUEST_HEAD = 8192;     // Longer heads get 431
+static const size_t MAX_REQUEST_BODY = 65536;    // Longer bodies get 413
+static const size_t MAX_EVENT_BACKLOG = 262144;  // Unsent SSE bytes before a stream is dropped
+static const int MAX_UPDATES_PER_POLL = 16;      // update() calls to finish forwarded requests
+
+// epoll data for the two descriptors that aren't connections
+static const uint64_t LISTEN_ID = 0;
+static const uint64_t WAKE_ID = 1;
+static const uint64_t FIRST_CONNECTION_ID = 2;
+
+// ----------------------------------------------------------------------------
+// Snapshot
+// ----------------------------------------------------------------------------
+
+// One rendering of the page and /get, shared read-only by every worker
+struct GatewaySnapshot {
+    unsigned long long version;
+    std::string pageBody;
+    std::string valuesBody;
+    std::string page[2];          // Full responses: [0] closes, [1] keeps alive
+    std::string values[2];
+    std::string event;            // "data: {...}\n\n" for /events
+};
+
+static std::string buildResponse(const std::string& contentType, const std::string& body, bool keepAlive) {
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Type: " + contentType +
+                           "\r\nContent-Length: " + std::to_string(body.size()) +
+                           "\r\nCache-Control: no-store\r\nConnection: " +
+                           (keepAlive ? "keep-alive" : "close") + "\r\n\r\n";
+    return response + body;
+}
+
+// Appends what the library renders to a snapshot body
+class GatewayBodyPrint : public Print {
+  public:
+    explicit GatewayBodyPrint(std::string& body) : body(body) {}
+    size_t write(uint8_t c) override { body += (char)c; return 1; }
+    size_t write(const uint8_t* data, size_t size) override { body.append((const char*)data, size); return size; }
+    using Print::write;
+
+  private:
+    std::string& body;
+};
+
+static std::string errorResponse(const char* status) {
+    return std::string("HTTP/1.1 ") + status +
+           "\r\nContent-Type: text/plain\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+}
+
+// The library closes every connection and doesn't always send a length;
+// restate both so the client can keep the connection
+static std::string reframe(const std::string& response, bool keepAlive) {
+    size_t split = response.find("\r\n\r\n");
+    if (split == std::string::npos) return errorResponse("502 Bad Gateway");
+
+    std::string head;
+    size_t line = 0;
+    while (line < split) {
+        size_t end = response.find("\r\n", line);
+        if (end > split) end = split;
+        std::string header = response.substr(line, end - line);
+        std::string lower = header;
+        for (char& c : lower) c = (char)tolower((unsigned char)c);
+        if (lower.compare(0, 11, "connection:") != 0 && lower.compare(0, 15, "content-length:") != 0) {
+            head += header + "\r\n";
+        }
+        line = end + 2;
+    }
+    size_t bodyLength = response.size() - split - 4;
+    head += "Content-Length: " + std::to_string(bodyLength) +
+            "\r\nConnection: " + (keepAlive ? "keep-alive" : "close") + "\r\n\r\n";
+    return head + response.substr(split + 4);
+}
+
+// ----------------------------------------------------------------------------
+// Worker: one thread, one epoll loop, one listening socket
+// ----------------------------------------------------------------------------
+
+struct GatewayConnection {
+    int fd = -1;
+    std::string in;
+    std::string out;
+    size_t outPos = 0;
+    bool keepAlive = true;
+    bool waiting = false;         // Forwarded; the library's response isn't back yet
+    bool events = false;          // An /events stream
+    bool closeWhenSent = false;
+    bool wantWrite = false;       // EPOLLOUT is armed
+};
+
+struct GatewayWorker {
+    explicit GatewayWorker(WebGUIGateway& gateway) : gateway(gateway) {}
+
+    bool open(const GatewayOptions& options, uint16_t port);
+    void run();
+    void close();
+
+    // From the main thread
+    void respond(uint64_t id, std::string response);
+    void wake();
+
+    WebGUIGateway& gateway;
+    int epoll = -1;
+    int listenSocket = -1;
+    int wakeFd = -1;
+    size_t maxClients = 0;
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    std::mutex responseLock;
+    std::vector<std::pair<uint64_t, std::string>> responses;
+
+    std::atomic<unsigned long long> snapshotResponses{0};
+    std::atomic<unsigned long long> eventsSent{0};
+    std::atomic<unsigned long> connectionCount{0};
+    std::atomic<unsigned long> eventStreamCount{0};
+
+  private:
+    void accept();
+    void receive(uint64_t id, GatewayConnection& connection);
+    void handleInput(uint64_t id, GatewayConnection& connection);
+    void serve(GatewayConnection& connection, const std::string* responses);
+    void startEvents(GatewayConnection& connection);
+    bool flush(uint64_t id, GatewayConnection& connection);
+    void setWriteInterest(uint64_t id, GatewayConnection& connection, bool enable);
+    void drop(uint64_t id);
+    void takeWakeups();
+
+    std::unordered_map<uint64_t, GatewayConnection> connections;
+    std::vector<uint64_t> eventStreams;
+    uint64_t nextId = FIRST_CONNECTION_ID;
+    std::shared_ptr<const GatewaySnapshot> snapshot;
+};
+
+bool GatewayWorker::open(const GatewayOptions& options, uint16_t port) {
+    maxClients = options.maxClients;
+    listenSocket = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int on = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, options.address.c_str(), &address.sin_addr) != 1 ||
+        bind(listenSocket, (sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(listenSocket, 4096) != 0) {
+        return false;
+    }
+
+    epoll = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTEN_ID;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, listenSocket, &event);
+    event.data.u64 = WAKE_ID;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, wakeFd, &event);
+    return true;
+}
+
+void GatewayWorker::close() {
+    for (auto& entry : connections) ::close(entry.second.fd);
+    connections.clear();
+    eventStreams.clear();
+    if (listenSocket >= 0) ::close(listenSocket);
+    if (wakeFd >= 0) ::close(wakeFd);
+    if (epoll >= 0) ::close(epoll);
+    listenSocket = wakeFd = epoll = -1;
+}
+
+void GatewayWorker::wake() {
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+void GatewayWorker::respond(uint64_t id, std::string response) {
+    {
+        std::lock_guard<std::mutex> guard(responseLock);
+        responses.emplace_back(id, std::move(response));
+    }
+    wake();
+}
+
+void GatewayWorker::run() {
+    snapshot = std::atomic_load(&gateway.snapshot);
+    epoll_event events[256];
+    while (running.load(std::memory_order_relaxed)) {
+        int ready = epoll_wait(epoll, events, 256, -1);
+        for (int i = 0; i < ready; i++) {
+            uint64_t id = events[i].data.u64;
+            if (id == LISTEN_ID) {
+                accept();
+                continue;
+            }
+            if (id == WAKE_ID) {
+                takeWakeups();
+                continue;
+            }
+            auto found = connections.find(id);
+            if (found == connections.end()) continue;    // Dropped earlier in this batch
+            GatewayConnection& connection = found->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                drop(id);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flush(id, connection)) continue;
+            if (events[i].events & EPOLLIN) receive(id, connection);
+        }
+    }
+}
+
+void GatewayWorker::accept() {
+    for (;;) {
+        int fd = accept4(listenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;    // EAGAIN, or out of descriptors until some close
+        if (connections.size() >= maxClients) {
+            ::close(fd);
+            continue;
+        }
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+        uint64_t id = nextId++;
+        GatewayConnection& connection = connections[id];
+        connection.fd = fd;
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event);
+        connectionCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void GatewayWorker::takeWakeups() {
+    uint64_t count;
+    ssize_t got = read(wakeFd, &count, sizeof(count));
+    (void)got;
+
+    std::vector<std::pair<uint64_t, std::string>> ready;
+    {
+        std::lock_guard<std::mutex> guard(responseLock);
+        ready.swap(responses);
+    }
+    for (auto& response : ready) {
+        auto found = connections.find(response.first);
+        if (found == connections.end()) continue;    // The client left meanwhile
+        GatewayConnection& connection = found->second;
+        connection.out += reframe(response.second, connection.keepAlive);
+        connection.waiting = false;
+        if (!connection.keepAlive) connection.closeWhenSent = true;
+        handleInput(response.first, connection);    // Requests pipelined behind it
+    }
+
+    std::shared_ptr<const GatewaySnapshot> latest = std::atomic_load(&gateway.snapshot);
+    if (latest == snapshot) return;
+    snapshot = latest;
+    for (size_t i = 0; i < eventStreams.size();) {
+        uint64_t id = eventStreams[i];
+        GatewayConnection& connection = connections.find(id)->second;
+        if (connection.out.size() - connection.outPos > MAX_EVENT_BACKLOG) {
+            drop(id);    // Too slow to keep up; removes it from eventStreams
+            continue;
+        }
+        connection.out += snapshot->event;
+        eventsSent.fetch_add(1, std::memory_order_relaxed);
+        if (flush(id, connection)) i++;
+    }
+}
+
+void GatewayWorker::receive(uint64_t id, GatewayConnection& connection) {
+    char buffer[16384];
+    bool peerClosed = false;
+    for (;;) {
+        ssize_t n = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            if (!connection.events) connection.in.append(buffer, n);
+            continue;
+        }
+        if (n == 0) {
+            peerClosed = true;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            drop(id);
+            return;
+        }
+        break;
+    }
+
+    if (peerClosed) {
+        // Serve what was sent, then close
+        connection.keepAlive = false;
+        handleInput(id, connection);
+        if (connections.count(id) && !connection.waiting && connection.outPos >= connection.out.size()) {
+            drop(id);
+        }
+        return;
+    }
+    handleInput(id, connection);
+}
+
+void GatewayWorker::handleInput(uint64_t id, GatewayConnection& connection) {
+    while (!connection.waiting && !connection.events && !connection.closeWhenSent) {
+        size_t headEnd = connection.in.find("\r\n\r\n");
+        if (headEnd == std::string::npos) {
+            if (connection.in.size() > MAX_REQUEST_HEAD) {
+                connection.out += errorResponse("431 Request Header Fields Too Large");
+                connection.closeWhenSent = true;
+            }
+            break;
+        }
+        size_t headLength = headEnd + 4;
+
+        std::string head = connection.in.substr(0, headLength);
+        std::string lower = head;
+        for (char& c : lower) c = (char)tolower((unsigned char)c);
+
+        size_t bodyLength = 0;
+        size_t lengthHeader = lower.find("\r\ncontent-length:");
+        if (lengthHeader != std::string::npos) {
+            bodyLength = strtoul(lower.c_str() + lengthHeader + 17, nullptr, 10);
+        }
+        if (bodyLength > MAX_REQUEST_BODY) {
+            connection.out += errorResponse("413 Payload Too Large");
+            connection.closeWhenSent = true;
+            break;
+        }
+        if (connection.in.size() < headLength + bodyLength) break;
+
+        std::string request = connection.in.substr(0, headLength + bodyLength);
+        connection.in.erase(0, headLength + bodyLength);
+
+        // Request line: METHOD SP target SP version
+        size_t methodEnd = head.find(' ');
+        size_t targetEnd = methodEnd == std::string::npos ? methodEnd : head.find(' ', methodEnd + 1);
+        size_t lineEnd = head.find("\r\n");
+        if (targetEnd == std::string::npos || targetEnd > lineEnd) {
+            connection.out += errorResponse("400 Bad Request");
+            connection.closeWhenSent = true;
+            break;
+        }
+        std::string method = head.substr(0, methodEnd);
+        std::string target = head.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+        std::string path = target.substr(0, target.find('?'));
+        bool http10 = head.compare(targetEnd + 1, 8, "HTTP/1.0") == 0;
+        if (http10) {
+            connection.keepAlive = connection.keepAlive && lower.find("\r\nconnection: keep-alive") != std::string::npos;
+        } else {
+            connection.keepAlive = connection.keepAlive && lower.find("\r\nconnection: close") == std::string::npos;
+        }
+
+        if (method == "GET" && snapshot && path == "/") {
+            serve(connection, snapshot->page);
+        } else if (method == "GET" && snapshot && path == "/get") {
+            serve(connection, snapshot->values);
+        } else if (method == "GET" && snapshot && path == "/events") {
+            startEvents(connection);
+            eventStreams.push_back(id);
+        } else {
+            connection.waiting = true;
+            gateway.forward(this, id, std::move(request));
+        }
+    }
+    flush(id, connection);
+}
+
+void GatewayWorker::serve(GatewayConnection& connection, const std::string* responses) {
+    connection.out += responses[connection.keepAlive ? 1 : 0];
+    if (!connection.keepAlive) connection.closeWhenSent = true;
+    snapshotResponses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GatewayWorker::startEvents(GatewayConnection& connection) {
+    connection.events = true;
+    connection.in.clear();
+    connection.out += "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+                      "Cache-Control: no-store\r\nConnection: keep-alive\r\n\r\n";
+    connection.out += snapshot->event;
+    eventStreamCount.fetch_add(1, std::memory_order_relaxed);
+    eventsSent.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Writes what the socket takes; false if the connection was dropped
+bool GatewayWorker::flush(uint64_t id, GatewayConnection& connection) {
+    while (connection.outPos < connection.out.size()) {
+        ssize_t n = send(connection.fd, connection.out.data() + connection.outPos,
+                         connection.out.size() - connection.outPos, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            connection.outPos += n;
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            setWriteInterest(id, connection, true);
+            return true;
+        }
+        drop(id);
+        return false;
+    }
+    connection.out.clear();
+    connection.outPos = 0;
+    setWriteInterest(id, connection, false);
+    if (connection.closeWhenSent) {
+        drop(id);
+        return false;
+    }
+    return true;
+}
+
+void GatewayWorker::setWriteInterest(uint64_t id, GatewayConnection& connection, bool enable) {
+    if (connection.wantWrite == enable) return;
+    connection.wantWrite = enable;
+    epoll_event event = {};
+    event.events = EPOLLIN | (enable ? EPOLLOUT : 0);
+    event.data.u64 = id;
+    epoll_ctl(epoll, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+void GatewayWorker::drop(uint64_t id) {
+    auto found = connections.find(id);
+    if (found == connections.end()) return;
+    if (found->second.events) {
+        for (size_t i = 0; i < eventStreams.size(); i++) {
+            if (eventStreams[i] == id) {
+                eventStreams[i] = eventStreams.back();
+                eventStreams.pop_back();
+                break;
+            }
+        }
+        eventStreamCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+    ::close(found->second.fd);    // Also removes it from the epoll set
+    connections.erase(found);
+    connectionCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// WebGUIGateway: the main thread's side
+// ----------------------------------------------------------------------------
+
+WebGUIGateway::WebGUIGateway()
+    : boundPort(0), wakeMain(-1), forwardedCount(0), snapshotCount(0), lastRefresh(0) {}
+
+WebGUIGateway::~WebGUIGateway() {
+    stop();
+}
+
+bool WebGUIGateway::start(const GatewayOptions& startOptions) {
+    options = startOptions;
+    unsigned count = options.workers ? options.workers : std::thread::hardware_concurrency();
+    if (count == 0) count = 1;
+
+    // Thousands of clients need more descriptors than the usual soft limit
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    wakeMain = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    refresh(true);
+
+    // Every worker binds the same port with SO_REUSEPORT and the kernel
+    // spreads new connections across them
+    uint16_t port = options.port;
+    for (unsigned i = 0; i < count; i++) {
+        std::unique_ptr<GatewayWorker> worker(new GatewayWorker(*this));
+        if (!worker->open(options, port)) {
+            worker->close();
+            stop();
+            return false;
+        }
+        if (i == 0) {
+            sockaddr_in bound = {};
+            socklen_t length = sizeof(bound);
+            getsockname(worker->listenSocket, (sockaddr*)&bound, &length);
+            port = ntohs(bound.sin_port);
+        }
+        workers.push_back(std::move(worker));
+    }
+    boundPort = port;
+
+    for (auto& worker : workers) {
+        worker->running = true;
+        GatewayWorker* w = worker.get();
+        worker->thread = std::thread([w] { w->run(); });
+    }
+    return true;
+}
+
+void WebGUIGateway::stop() {
+    for (auto& worker : workers) {
+        worker->running = false;
+        if (worker->thread.joinable()) {
+            worker->wake();
+            worker->thread.join();
+        }
+        worker->close();
+    }
+    workers.clear();
+    if (wakeMain >= 0) ::close(wakeMain);
+    wakeMain = -1;
+    queue.clear();
+    inFlight.clear();
+    boundPort = 0;
+}
+
+void WebGUIGateway::forward(GatewayWorker* worker, uint64_t id, std::string request) {
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        queue.push_back(Forwarded{worker, id, std::move(request), nullptr});
+    }
+    uint64_t one = 1;
+    ssize_t written = write(wakeMain, &one, sizeof(one));
+    (void)written;
+}
+
+void WebGUIGateway::poll(unsigned long timeoutMs) {
+    if (wakeMain < 0) return;
+
+    unsigned long sinceRefresh = millis() - lastRefresh;
+    unsigned long untilRefresh = sinceRefresh >= options.refreshMs ? 0 : options.refreshMs - sinceRefresh;
+    pollfd wait = {wakeMain, POLLIN, 0};
+    if (::poll(&wait, 1, (int)(timeoutMs < untilRefresh ? timeoutMs : untilRefresh)) > 0) {
+        uint64_t count;
+        ssize_t got = read(wakeMain, &count, sizeof(count));
+        (void)got;
+    }
+
+    std::deque<Forwarded> arrived;
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        arrived.swap(queue);
+    }
+    for (Forwarded& forwarded : arrived) {
+        forwarded.connection = WebGUIHost::connect(options.devicePort, forwarded.request);
+        inFlight.push_back(std::move(forwarded));
+    }
+
+    // update() serves one queued connection per call
+    size_t updates = inFlight.size() + MAX_UPDATES_PER_POLL;
+    for (size_t i = 0; i < updates && !inFlight.empty() && !inFlight.back().connection->closed; i++) {
+        GUI.update();
+    }
+
+    std::vector<Forwarded> done;
+    for (size_t i = 0; i < inFlight.size();) {
+        if (inFlight[i].connection->closed) {
+            done.push_back(std::move(inFlight[i]));
+            inFlight.erase(inFlight.begin() + i);
+        } else {
+            i++;
+        }
+    }
+    // A /set is in the snapshot before its client hears back
+    refresh(!done.empty());
+    for (Forwarded& forwarded : done) {
+        forwardedCount.fetch_add(1, std::memory_order_relaxed);
+        forwarded.worker->respond(forwarded.id, forwarded.connection->tx);
+    }
+}
+
+// Rendered directly rather than requested through update(), so snapshots
+// stay out of the library's metrics, trace and capture
+void WebGUIGateway::refresh(bool force) {
+    if (!force && snapshot && millis() - lastRefresh < options.refreshMs) return;
+    lastRefresh = millis();
+
+    std::string pageBody, valuesBody;
+    GatewayBodyPrint values(valuesBody);
+    GUI.renderValues(values);
+    if (!GUI.isSheddingLoad()) {
+        GatewayBodyPrint page(pageBody);
+        GUI.renderPage(page);
+    } else if (snapshot) {
+        pageBody = snapshot->pageBody;   // The library isn't serving pages; keep the last one
+    } else {
+        return;
+    }
+    if (snapshot && snapshot->valuesBody == valuesBody && snapshot->pageBody == pageBody) return;
+
+    std::shared_ptr<GatewaySnapshot> next = std::make_shared<GatewaySnapshot>();
+    next->version = ++snapshotCount;
+    next->pageBody = pageBody;
+    next->valuesBody = valuesBody;
+    for (int keepAlive = 0; keepAlive < 2; keepAlive++) {
+        next->page[keepAlive] = buildResponse("text/html", pageBody, keepAlive);
+        next->values[keepAlive] = buildResponse("application/json", valuesBody, keepAlive);
+    }
+    next->event = "data: " + valuesBody + "\n\n";
+
+    std::atomic_store(&snapshot, std::shared_ptr<const GatewaySnapshot>(next));
+    for (auto& worker : workers) worker->wake();
+}
+
+GatewayStats WebGUIGateway::stats() const {
+    GatewayStats stats;
+    stats.forwardedRequests = forwardedCount.load(std::memory_order_relaxed);
+    stats.snapshots = snapshotCount.load(std::memory_order_relaxed);
+    for (const auto& worker : workers) {
+        stats.snapshotResponses += worker->snapshotResponses.load(std::memory_order_relaxed);
+        stats.eventsSent += worker->eventsSent.load(std::memory_order_relaxed);
+        stats.connections += worker->connectionCount.load(std::memory_order_relaxed);
+        stats.eventStreams += worker->eventStreamCount.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
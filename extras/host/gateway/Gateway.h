@@ -0,0 +1,109 @@
+/*
+  Gateway.h - epoll front end that serves one WebGUI to many clients
+
+  For a Linux board (a Raspberry Pi or similar) that runs the sketch
+  itself. The sketch, its elements and the library stay on the main
+  thread, exactly as on a microcontroller; worker threads, each with its
+  own epoll loop and SO_REUSEPORT listening socket, own the connections:
+
+  - GET / and GET /get are answered from an immutable snapshot that the
+    main thread renders with GUI.renderPage() and GUI.renderValues() every
+    refreshMs and after every request it forwards. These aren't requests
+    to the library, so its metrics, trace and capture only show what was
+    forwarded. Workers never touch the library, so these scale with the
+    number of cores; connections are kept alive.
+  - GET /events is a Server-Sent Events stream of the /get JSON, pushed
+    whenever the snapshot changes.
+  - Everything else (/set, /debug/..., /metrics) is forwarded to the main
+    thread, run through the library as an in-memory connection, and the
+    response sent back with a Content-Length so the connection can stay
+    open.
+
+  The snapshot is re-rendered before a forwarded request's response goes
+  out, so a client that sends /set and then /get sees its own change.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_Gateway_h
+#define WebGUIHost_Gateway_h
+
+#include <HostNetwork.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct GatewayWorker;
+struct GatewaySnapshot;
+
+struct GatewayOptions {
+    std::string address = "127.0.0.1";
+    uint16_t port = 8080;             // 0 picks a free port
+    uint16_t devicePort = 80;         // The port the sketch's GUI listens on
+    unsigned workers = 0;             // 0: one per core
+    unsigned long refreshMs = 100;    // How stale a snapshot may get
+    size_t maxClients = 20000;        // Per worker; later connections are refused
+};
+
+struct GatewayStats {
+    unsigned long long snapshotResponses = 0;   // Served by workers
+    unsigned long long forwardedRequests = 0;   // Run through the library
+    unsigned long long snapshots = 0;           // Snapshots that changed
+    unsigned long long eventsSent = 0;          // SSE messages written
+    unsigned long connections = 0;              // Open right now
+    unsigned long eventStreams = 0;             // Of which /events
+};
+
+class WebGUIGateway {
+  public:
+    WebGUIGateway();
+    ~WebGUIGateway();
+
+    // Opens the listening sockets and starts the workers. Call after
+    // GUI.begin(); false if the port can't be bound.
+    bool start(const GatewayOptions& options);
+    void stop();
+
+    // The port clients connect to (the bound one when options.port is 0)
+    uint16_t port() const { return boundPort; }
+
+    // Main thread, between loop() calls: runs forwarded requests through
+    // the library and refreshes the snapshot. Sleeps at most timeoutMs
+    // waiting for work.
+    void poll(unsigned long timeoutMs);
+
+    GatewayStats stats() const;
+
+  private:
+    struct Forwarded {
+        GatewayWorker* worker;
+        uint64_t id;                  // Connection, as the worker knows it
+        std::string request;
+        std::shared_ptr<HostConnection> connection;
+    };
+
+    void refresh(bool force);
+
+    friend struct GatewayWorker;
+    void forward(GatewayWorker* worker, uint64_t id, std::string request);
+
+    GatewayOptions options;
+    uint16_t boundPort;
+    std::vector<std::unique_ptr<GatewayWorker>> workers;
+
+    // Worker -> main thread
+    std::mutex queueLock;
+    std::deque<Forwarded> queue;
+    int wakeMain;                     // eventfd
+    std::vector<Forwarded> inFlight;  // Main thread only
+
+    std::shared_ptr<const GatewaySnapshot> snapshot;
+    std::atomic<unsigned long long> forwardedCount;
+    std::atomic<unsigned long long> snapshotCount;
+    unsigned long lastRefresh;
+};
+
+#endif
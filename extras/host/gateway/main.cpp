@@ -0,0 +1,71 @@
+/*
+  main.cpp - Runs an Arduino sketch behind the epoll gateway
+
+  Like sketch/main.cpp, but browsers talk to WebGUIGateway instead of the
+  sketch's WiFiServer: worker threads serve the page, /get and /events
+  to thousands of clients, and the sketch's loop() and GUI.update() keep
+  the main thread to themselves.
+
+    ./build/gateway_station_save_settings_esp32 --port 8080 --workers 4
+    wrk -t4 -c1000 -d10s http://127.0.0.1:8080/get
+    curl -N http://127.0.0.1:8080/events
+
+  usage: gateway [--address 127.0.0.1] [--port 8080] [--workers N]
+                 [--refresh 100] [--stats]
+
+  --refresh is how stale /get may get, in ms (the page polls every 100);
+  --stats prints request counts every 10 seconds.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "Gateway.h"
+#include <string>
+
+void setup();
+void loop();
+
+int main(int argc, char** argv) {
+    GatewayOptions options;
+    bool printStats = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--address" && i + 1 < argc) {
+            options.address = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            options.port = (uint16_t)strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            options.workers = (unsigned)strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--refresh" && i + 1 < argc) {
+            options.refreshMs = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--stats") {
+            printStats = true;
+        } else {
+            fprintf(stderr, "usage: %s [--address 127.0.0.1] [--port 8080] [--workers N] "
+                            "[--refresh 100] [--stats]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    setup();
+    WebGUIGateway gateway;
+    if (!gateway.start(options)) {
+        fprintf(stderr, "Cannot listen on %s:%u\n", options.address.c_str(), options.port);
+        return 1;
+    }
+    fprintf(stderr, "Serving http://%s:%u/\n", options.address.c_str(), gateway.port());
+
+    unsigned long lastStats = millis();
+    for (;;) {
+        loop();
+        gateway.poll(1);
+        if (printStats && millis() - lastStats >= 10000) {
+            lastStats = millis();
+            GatewayStats stats = gateway.stats();
+            fprintf(stderr, "snapshot %llu forwarded %llu snapshots %llu events %llu open %lu streams %lu\n",
+                    stats.snapshotResponses, stats.forwardedRequests, stats.snapshots,
+                    stats.eventsSent, stats.connections, stats.eventStreams);
+        }
+    }
+}
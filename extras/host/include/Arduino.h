@@ -0,0 +1,345 @@
+/*
+  Arduino.h - Minimal Arduino core shim for the WebGUI host build
+
+  Provides just enough of the Arduino API (String, Print, Stream, IPAddress,
+  timing, PROGMEM helpers) for WebGUI.cpp to compile and run on Linux.
+  Not a general purpose Arduino emulator.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_Arduino_h
+#define WebGUIHost_Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+
+#define WEBGUI_HOST 1
+
+// ----------------------------------------------------------------------------
+// PROGMEM: flash and RAM are the same address space on the host
+// ----------------------------------------------------------------------------
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+#define pgm_read_byte(addr) (*(const unsigned char*)(addr))
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define memcpy_P memcpy
+
+// ----------------------------------------------------------------------------
+// Timing (see HostClock.cpp)
+// ----------------------------------------------------------------------------
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void yield();
+
+// Host-only: a virtual clock for deterministic timing tests. From this call
+// on, millis() and micros() start at startMillis and move only when the
+// program (or delay(), or an emulated link) advances them.
+void hostUseVirtualClock(unsigned long startMillis = 0);
+bool hostClockIsVirtual();
+// Let time pass: moves the virtual clock, or sleeps on the real one
+void hostAdvanceMicros(unsigned long us);
+
+// ----------------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------------
+template <typename T, typename L, typename H>
+inline T constrain(T value, L low, H high) {
+    return value < (T)low ? (T)low : (value > (T)high ? (T)high : value);
+}
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+inline bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+char* dtostrf(double value, signed char width, unsigned char prec, char* buffer);
+char* ltoa(long value, char* buffer, int radix);
+char* itoa(int value, char* buffer, int radix);
+char* utoa(unsigned value, char* buffer, int radix);
+char* ultoa(unsigned long value, char* buffer, int radix);
+
+#define DEC 10
+#define HEX 16
+
+// ----------------------------------------------------------------------------
+// String
+// ----------------------------------------------------------------------------
+// Like the Arduino core's String, the text lives in a buffer from
+// malloc/realloc with no small-string optimization, so every non-empty
+// String is a heap allocation the allocation hooks see as on a board. An
+// empty String holds no buffer.
+class String {
+  public:
+    String() {}
+    String(const char* s) { copy(s, s ? strlen(s) : 0); }
+    String(const __FlashStringHelper* s) : String(reinterpret_cast<const char*>(s)) {}
+    String(const String& other) { copy(other.buffer, other.len); }
+    String(String&& other) noexcept { move(other); }
+    explicit String(char c) { copy(&c, 1); }
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(float value, unsigned char decimals = 2);
+    explicit String(double value, unsigned char decimals = 2);
+    ~String() { free(buffer); }
+
+    String& operator=(const String& other) { if (this != &other) copy(other.buffer, other.len); return *this; }
+    String& operator=(String&& other) noexcept { if (this != &other) { free(buffer); move(other); } return *this; }
+    String& operator=(const char* other) { copy(other, other ? strlen(other) : 0); return *this; }
+    String& operator=(const __FlashStringHelper* other) { return *this = reinterpret_cast<const char*>(other); }
+
+    bool reserve(unsigned int size);
+    unsigned int length() const { return len; }
+    const char* c_str() const { return buffer ? buffer : ""; }
+    char* begin() { return buffer; }
+
+    bool concat(const String& other) { return concat(other.buffer, other.len); }
+    bool concat(const char* other) { return other ? concat(other, strlen(other)) : true; }
+    bool concat(const char* other, unsigned int length);
+    bool concat(char c) { return concat(&c, 1); }
+    bool concat(int value) { return concat(String(value)); }
+    bool concat(unsigned int value) { return concat(String(value)); }
+    bool concat(long value) { return concat(String(value)); }
+    bool concat(unsigned long value) { return concat(String(value)); }
+    bool concat(float value) { return concat(String(value)); }
+    bool concat(double value) { return concat(String(value)); }
+    bool concat(const __FlashStringHelper* other) { return concat(reinterpret_cast<const char*>(other)); }
+
+    template <typename T>
+    String& operator+=(const T& rhs) { concat(rhs); return *this; }
+
+    friend String operator+(const String& lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, const char* rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const char* lhs, const String& rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, char rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, int rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, unsigned int rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, long rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, unsigned long rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, float rhs) { String r(lhs); r.concat(rhs); return r; }
+    friend String operator+(const String& lhs, double rhs) { String r(lhs); r.concat(rhs); return r; }
+
+    bool equals(const String& other) const { return len == other.len && memcmp(c_str(), other.c_str(), len) == 0; }
+    bool equals(const char* other) const { return strcmp(c_str(), other ? other : "") == 0; }
+    bool operator==(const String& other) const { return equals(other); }
+    bool operator==(const char* other) const { return equals(other); }
+    bool operator!=(const String& other) const { return !equals(other); }
+    bool operator!=(const char* other) const { return !equals(other); }
+    bool operator<(const String& other) const { return strcmp(c_str(), other.c_str()) < 0; }
+
+    char charAt(unsigned int index) const { return index < len ? buffer[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return buffer[index]; }
+
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String& str, unsigned int from = 0) const { return indexOf(str.c_str(), from); }
+    int indexOf(const char* str, unsigned int from = 0) const;
+    int lastIndexOf(char c) const;
+    int lastIndexOf(const String& str) const;
+    bool startsWith(const String& prefix) const {
+        return len >= prefix.len && memcmp(c_str(), prefix.c_str(), prefix.len) == 0;
+    }
+    bool endsWith(const String& suffix) const {
+        return len >= suffix.len && memcmp(c_str() + len - suffix.len, suffix.c_str(), suffix.len) == 0;
+    }
+
+    String substring(unsigned int from) const { return substring(from, length()); }
+    String substring(unsigned int from, unsigned int to) const;
+
+    void replace(const String& find, const String& replacement);
+    void replace(char find, char replacement);
+    void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+    void remove(unsigned int index, unsigned int count);
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const { return strtol(c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(c_str(), nullptr); }
+    double toDouble() const { return strtod(c_str(), nullptr); }
+
+  private:
+    char* buffer = nullptr;
+    unsigned int capacity = 0;   // Not counting the terminator
+    unsigned int len = 0;
+
+    void copy(const char* text, unsigned int length);
+    void move(String& other) {
+        buffer = other.buffer;
+        capacity = other.capacity;
+        len = other.len;
+        other.buffer = nullptr;
+        other.capacity = 0;
+        other.len = 0;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Print / Stream
+// ----------------------------------------------------------------------------
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const __FlashStringHelper* str) { return write(reinterpret_cast<const char*>(str)); }
+    size_t print(const String& str) { return write(str.c_str(), str.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int decimals = 2);
+
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+    size_t println() { return write("\r\n"); }
+
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+// Serial is a stdout-backed Stream; the host build can silence it
+class HostSerial : public Stream {
+  public:
+    void begin(unsigned long) {}
+    operator bool() const { return true; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    int availableForWrite() override { return writeRoom; }
+    void flush() override { fflush(stdout); }
+
+    // Host-only: suppress output (benchmarks, fuzzing)
+    void setQuiet(bool quiet) { this->quiet = quiet; }
+    // Host-only: what availableForWrite() reports; 0 acts like a port
+    // that doesn't know
+    void setWriteRoom(int room) { writeRoom = room; }
+
+  private:
+    bool quiet = false;
+    int writeRoom = 64;
+};
+
+extern HostSerial Serial;
+
+// ----------------------------------------------------------------------------
+// IPAddress
+// ----------------------------------------------------------------------------
+class IPAddress {
+  public:
+    IPAddress() : bytes{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+    explicit IPAddress(uint32_t address) { memcpy(bytes, &address, 4); }
+
+    bool fromString(const char* address);
+    bool fromString(const String& address) { return fromString(address.c_str()); }
+    String toString() const;
+
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t& operator[](int index) { return bytes[index]; }
+    operator uint32_t() const { uint32_t v; memcpy(&v, bytes, 4); return v; }
+    bool operator==(const IPAddress& other) const { return memcmp(bytes, other.bytes, 4) == 0; }
+
+  private:
+    uint8_t bytes[4];
+};
+
+// ----------------------------------------------------------------------------
+// Pins (see HostPins.cpp): writes are remembered and read back, so sketches
+// run unchanged. Nothing is attached to them.
+// ----------------------------------------------------------------------------
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LED_BUILTIN 13
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+int analogRead(uint8_t pin);
+
+// Host-only: what analogRead() returns for a pin (default 512)
+void hostSetAnalogInput(uint8_t pin, int value);
+
+// ----------------------------------------------------------------------------
+// Platform odds and ends
+// ----------------------------------------------------------------------------
+
+// Free heap the library sees on every personality, through ESP.getFreeHeap().
+// Lower it to exercise load shedding.
+extern uint32_t hostFreeHeap;
+
+// The ESP-style heap API on every personality: a PC has no sbrk() heap or
+// stack region for the newlib telemetry to inspect
+#define WEBGUI_ESP_HEAP_API 1
+class EspClass {
+  public:
+#if defined(ESP32)
+    void restart();
+#endif
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getHeapSize();
+};
+extern EspClass ESP;
+unsigned uxTaskGetStackHighWaterMark(void* task);
+
+#if !defined(ESP32)
+void NVIC_SystemReset();
+#endif
+
+// One handle per thread on every personality, so the allocation hooks can
+// tell loop()'s thread from the gateway's workers
+typedef void* TaskHandle_t;
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+#endif
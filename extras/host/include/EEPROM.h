@@ -0,0 +1,47 @@
+/*
+  EEPROM.h - RAM-backed EEPROM for the WebGUI host build (UNO R4 personality)
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_EEPROM_h
+#define WebGUIHost_EEPROM_h
+
+#include "Arduino.h"
+
+class EEPROMClass {
+  public:
+    static const int SIZE = 8192;
+
+    void begin() {}
+    bool commit() { return true; }
+    uint16_t length() const { return SIZE; }
+
+    uint8_t read(int address) const { return inRange(address, 1) ? data[address] : 0xFF; }
+    void write(int address, uint8_t value) { if (inRange(address, 1)) { data[address] = value; writes++; } }
+    void update(int address, uint8_t value) { if (read(address) != value) write(address, value); }
+
+    template <typename T>
+    T& get(int address, T& value) const {
+        if (inRange(address, sizeof(T))) memcpy(&value, data + address, sizeof(T));
+        return value;
+    }
+    template <typename T>
+    const T& put(int address, const T& value) {
+        if (inRange(address, sizeof(T))) { memcpy(data + address, &value, sizeof(T)); writes++; }
+        return value;
+    }
+
+    // Host-only: number of write()/put() calls
+    unsigned long writeCount() const { return writes; }
+
+  private:
+    uint8_t data[SIZE] = {};
+    unsigned long writes = 0;
+
+    static bool inRange(int address, size_t size) { return address >= 0 && address + size <= (size_t)SIZE; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
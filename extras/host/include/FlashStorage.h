@@ -0,0 +1,30 @@
+/*
+  FlashStorage.h - RAM-backed FlashStorage for the WebGUI host build (Nano 33 IoT personality)
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_FlashStorage_h
+#define WebGUIHost_FlashStorage_h
+
+#include "Arduino.h"
+
+template <class T>
+class FlashStorageClass {
+  public:
+    FlashStorageClass() { memset(&value, 0, sizeof(T)); }
+    T read() { return value; }
+    void read(T* out) { *out = value; }
+    void write(T data) { value = data; writes++; }
+
+    // Host-only: number of write() calls
+    unsigned long writeCount() const { return writes; }
+
+  private:
+    T value;
+    unsigned long writes = 0;
+};
+
+#define FlashStorage(name, T) FlashStorageClass<T> name
+
+#endif
@@ -0,0 +1,181 @@
+/*
+  HostNetwork.h - In-memory WiFi, WiFiServer and WiFiClient for the WebGUI host build
+
+  Connections are scripted by the host program: WebGUIHost::connect() queues
+  a client with its request bytes, the library accepts it through
+  WiFiServer::available(), and the response can be read back from the
+  returned HostConnection once update() has run.
+
+  Connected with a HostLink, a client behaves like one on a real network:
+  request bytes arrive over time, may stall, and write() blocks while the
+  send window is full. Timed by micros(), so with hostUseVirtualClock()
+  the same link gives the same timings on every run.
+
+  After WebGUIHost::useSockets() the same classes run over real TCP
+  instead: WiFiServer::begin() listens on a localhost port and browsers,
+  curl, wrk or ab can connect to it. Sockets never block update() for
+  reading; a response is written out in full before stop() returns.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_HostNetwork_h
+#define WebGUIHost_HostNetwork_h
+
+#include "Arduino.h"
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum wl_status_t {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_DISCONNECTED = 6
+};
+
+// An emulated link between a client and the device. Rates apply to both
+// directions; a lost segment arrives retransmitMicros late.
+struct HostLink {
+    unsigned long latencyMicros = 0;        // One way
+    unsigned long bytesPerSecond = 0;       // 0: unlimited
+    float loss = 0;                         // Chance each segment is lost, 0..1
+    unsigned long retransmitMicros = 200000;
+    size_t segmentSize = 1460;
+    size_t sendWindow = 5840;               // Unacknowledged response bytes before write() blocks
+    size_t stallAfter = (size_t)-1;         // The client sends this much of the request, then goes silent
+    unsigned long pollMicros = 100;         // Virtual time an available() that finds nothing costs
+    uint32_t seed = 1;                      // For loss
+};
+
+// One accepted TCP connection, as seen from both ends
+struct HostConnection {
+    uint16_t port = 0;
+    IPAddress remoteIP = IPAddress(192, 168, 4, 2);
+    std::string rx;           // bytes the peer sends to the device
+    size_t rxPos = 0;
+    std::string tx;           // bytes the device sends to the peer
+    bool peerDone = true;     // peer has nothing more to send
+    bool closed = false;      // device called stop()
+    int socket = -1;          // Real TCP connection (useSockets()), or -1
+
+    // Link emulation (connect() with a HostLink); times are micros()
+    bool emulated = false;
+    HostLink link;
+    uint32_t lossState = 1;
+    std::vector<std::pair<size_t, unsigned long>> arrivals;  // rx bytes up to first are in at second
+    std::deque<std::pair<size_t, unsigned long>> unacked;    // tx bytes in flight, acknowledged at second
+    size_t unackedBytes = 0;
+    unsigned long openedMicros = 0;     // The client calls connect()
+    unsigned long acceptMicros = 0;     // Handshake done: WiFiServer::available() returns it
+    unsigned long sentMicros = 0;       // The last tx byte leaves the device
+    unsigned long deliveredMicros = 0;  // The client has every tx byte so far
+    unsigned long blockedMicros = 0;    // Time write() waited for the send window
+
+    ~HostConnection();        // Closes a socket the library never stopped
+};
+
+namespace WebGUIHost {
+    // Queue a client connection carrying the given request bytes
+    std::shared_ptr<HostConnection> connect(uint16_t port, const std::string& request,
+                                            IPAddress remote = IPAddress(192, 168, 4, 2));
+    // The same over an emulated link, opened at micros() now
+    std::shared_ptr<HostConnection> connect(uint16_t port, const std::string& request, const HostLink& link,
+                                            IPAddress remote = IPAddress(192, 168, 4, 2));
+    // Number of queued connections not yet accepted on a port
+    size_t pending(uint16_t port);
+    // Body of an HTTP response (everything after the blank line)
+    std::string responseBody(const HostConnection& connection);
+    // Status code of an HTTP response, 0 if none was sent
+    int responseStatus(const HostConnection& connection);
+
+    // Serve WiFiServer over real TCP on address from now on; connect() no
+    // longer applies. Call before GUI.begin().
+    void useSockets(const char* address = "127.0.0.1");
+    // Listen on hostPort when the sketch asks for devicePort, since ports
+    // below 1024 need root; 0 picks a free port
+    void mapPort(uint16_t devicePort, uint16_t hostPort);
+    // The port a WiFiServer for devicePort is listening on, 0 if none
+    uint16_t listeningPort(uint16_t devicePort);
+    // Sleep until a connection or request bytes arrive, at most timeoutMs,
+    // so a sketch's loop doesn't spin a core while idle
+    void waitForSockets(unsigned long timeoutMs);
+}
+
+class WiFiClient : public Stream {
+  public:
+    WiFiClient() {}
+    explicit WiFiClient(std::shared_ptr<HostConnection> connection) : connection(connection) {}
+
+    uint8_t connected();
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size);
+    int peek() override;
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+    void stop();
+    void setTimeout(unsigned long) {}
+    IPAddress remoteIP() const { return connection ? connection->remoteIP : IPAddress(); }
+
+    operator bool() const { return connection != nullptr && !connection->closed; }
+    bool operator==(const WiFiClient& other) const { return connection == other.connection; }
+
+  private:
+    std::shared_ptr<HostConnection> connection;
+};
+
+class WiFiServer {
+  public:
+    explicit WiFiServer(uint16_t port = 80) : port(port) {}
+    ~WiFiServer() { end(); }
+    void begin();
+    void end();
+    void stop() { end(); }
+    WiFiClient available();
+    WiFiClient accept() { return available(); }
+
+  private:
+    uint16_t port;
+    bool listening = false;
+    int listenSocket = -1;
+};
+
+class WiFiClass {
+  public:
+    int begin(const char* ssid, const char* password = nullptr);
+    int beginAP(const char* ssid, const char* password = nullptr);
+    bool softAP(const char* ssid, const char* password = nullptr);
+    bool config(IPAddress ip, IPAddress gateway, IPAddress subnet);
+    int disconnect();
+    uint8_t status();
+
+    IPAddress localIP() { return ip; }
+    IPAddress softAPIP() { return apIP; }
+    IPAddress subnetMask() { return subnet; }
+    IPAddress gatewayIP() { return gateway; }
+    String SSID() { return ssid; }
+    int32_t RSSI() { return currentStatus == WL_CONNECTED ? -55 : 0; }
+
+    // Host-only: how many status() polls a begin() takes to associate
+    void setAssociationPolls(int polls) { associationPolls = polls; }
+
+  private:
+    IPAddress ip = IPAddress(192, 168, 1, 57);
+    IPAddress apIP = IPAddress(192, 168, 4, 1);
+    IPAddress subnet = IPAddress(255, 255, 255, 0);
+    IPAddress gateway = IPAddress(192, 168, 1, 1);
+    bool staticConfig = false;
+    IPAddress staticIP;
+    String ssid;
+    int associationPolls = 1;
+    int pollsRemaining = 0;
+    uint8_t currentStatus = WL_IDLE_STATUS;
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,36 @@
+/*
+  Preferences.h - In-memory ESP32 Preferences for the WebGUI host build
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_Preferences_h
+#define WebGUIHost_Preferences_h
+
+#include "Arduino.h"
+
+class Preferences {
+  public:
+    bool begin(const char* name, bool readOnly = false);
+    void end() {}
+    bool clear();
+
+    size_t putInt(const char* key, int32_t value);
+    size_t putFloat(const char* key, float value);
+    size_t putBool(const char* key, bool value);
+    size_t putString(const char* key, const char* value);
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    float getFloat(const char* key, float defaultValue = NAN);
+    bool getBool(const char* key, bool defaultValue = false);
+    String getString(const char* key, const String& defaultValue = String());
+
+    // Host-only: number of put*() calls across all namespaces
+    static unsigned long writeCount();
+
+  private:
+    std::string ns;
+};
+
+#endif
@@ -0,0 +1,71 @@
+/*
+  WebServer.h - Minimal ESP32 WebServer for the WebGUI host build
+
+  Accepts connections from the in-memory WiFiServer, parses the request line
+  and query string, and dispatches to the registered handlers the same way
+  the ESP32 core does for simple GET routes.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIHost_WebServer_h
+#define WebGUIHost_WebServer_h
+
+#include "HostNetwork.h"
+#include <functional>
+#include <vector>
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer {
+  public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80) : server(port) {}
+
+    void begin() { server.begin(); }
+    void stop() { server.end(); }
+    void handleClient();
+
+    void on(const String& uri, THandlerFunction handler) { routes.push_back({uri, handler}); }
+    void onNotFound(THandlerFunction handler) { notFound = handler; }
+
+    String uri() { return currentUri; }
+    int args() { return (int)currentArgs.size(); }
+    String arg(int i) { return i < args() ? currentArgs[i].value : String(); }
+    String argName(int i) { return i < args() ? currentArgs[i].name : String(); }
+    String arg(const String& name);
+    bool hasArg(const String& name);
+
+    void setContentLength(size_t length) { contentLength = length; }
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void send(int code, const char* contentType = nullptr, const String& content = String());
+    void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+    void send_P(int code, PGM_P contentType, PGM_P content);
+    void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content, size_t length);
+    void sendContent_P(PGM_P content) { sendContent(content, strlen(content)); }
+
+    WiFiClient client() { return currentClient; }
+
+  private:
+    struct Route { String uri; THandlerFunction handler; };
+    struct Arg { String name; String value; };
+
+    WiFiServer server;
+    std::vector<Route> routes;
+    THandlerFunction notFound;
+
+    WiFiClient currentClient;
+    String currentUri;
+    std::vector<Arg> currentArgs;
+    String extraHeaders;
+    size_t contentLength = CONTENT_LENGTH_UNKNOWN;
+    bool chunked = false;
+
+    bool parseRequest(WiFiClient& client);
+    void sendHeaders(int code, const char* contentType, size_t length);
+};
+
+#endif
@@ -0,0 +1,3 @@
+// WiFi.h - host build: see HostNetwork.h
+#pragma once
+#include "HostNetwork.h"
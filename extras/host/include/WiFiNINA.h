@@ -0,0 +1,3 @@
+// WiFiNINA.h - host build: see HostNetwork.h
+#pragma once
+#include "HostNetwork.h"
@@ -0,0 +1,3 @@
+// WiFiS3.h - host build: see HostNetwork.h
+#pragma once
+#include "HostNetwork.h"
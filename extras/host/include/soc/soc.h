@@ -0,0 +1,9 @@
+/*
+  soc/soc.h - ESP32 memory map constants for the WebGUI host build
+
+  The host has no flash region; an empty DROM range makes every pointer
+  count as RAM, so element text is always copied.
+*/
+#pragma once
+#define SOC_DROM_LOW  1
+#define SOC_DROM_HIGH 1
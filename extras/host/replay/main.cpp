@@ -0,0 +1,292 @@
+/*
+  main.cpp - Replays a recorded request capture against an Arduino sketch
+
+  Runs the sketch's setup(), then sends it each request of a capture
+  (GUI.dumpCapture() or /debug/capture, see WebGUICapture.h) at the time
+  it arrived on the device, calling loop() in between as the board did.
+  Time is virtual: gaps cost nothing, and the library sees the same
+  millis() from run to run. Reported per path:
+    p50/p99 us   host CPU time from the request arriving to the device
+                 closing the connection, loop() calls included
+    allocs       heap allocations per request inside update()
+                 (WEBGUI_ALLOC_STATS) and the bytes they asked for
+    errors       requests not answered with 200
+
+  Build the same sketch against two versions of the library and replay
+  the same capture: --summary writes the figures to a file and --compare
+  prints the change from one written earlier.
+
+    curl -s 'http://<device-ip>/debug/capture?stop' > session.capture
+    ./build/replay_esp32 --rounds 20 --summary before.txt session.capture
+    (update the library, rebuild)
+    ./build/replay_esp32 --rounds 20 --compare before.txt session.capture
+
+  A .http corpus (requests back to back, as in corpus/) is replayed too,
+  every request at time 0.
+
+  usage: replay [--rounds 1] [--port 80] [--summary file] [--compare file]
+                [--strict] [--verbose] capture
+
+  --strict fails the run if any request isn't answered with 200;
+  --verbose shows the sketch's Serial output.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "../bench/BenchCommon.h"
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <sstream>
+
+void setup();
+void loop();
+
+static const unsigned long LOOP_MICROS = 100;     // Virtual time a loop() without delay() takes
+static const unsigned long GIVE_UP_MICROS = 60000000;
+
+struct CapturedRequest {
+    unsigned long millis;      // Since the capture started
+    std::string bytes;
+};
+
+struct PathResults {
+    BenchSamples micros;
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    unsigned long errors = 0;
+};
+
+struct SummaryLine {
+    unsigned long requests;
+    double p50;
+    double p99;
+    double allocations;
+    double allocatedBytes;
+};
+
+// The capture format, after anything that came before its first line (a
+// serial log, say); a file without one is read as a .http corpus
+static bool loadCapture(const std::string& path, std::vector<CapturedRequest>& requests) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t position = text.find("# webgui-capture 1");
+    if (position == std::string::npos) {
+        for (const std::string& request : benchLoadCorpus(path)) {
+            requests.push_back({0, request});
+        }
+        return true;
+    }
+
+    while (position < text.size()) {
+        size_t lineEnd = text.find('\n', position);
+        if (lineEnd == std::string::npos) break;
+        std::string line = text.substr(position, lineEnd - position);
+        position = lineEnd + 1;
+        unsigned long millis, length;
+        if (sscanf(line.c_str(), "@%lu %lu", &millis, &length) != 2) {
+            continue;   // Header lines
+        }
+        if (position + length > text.size()) {
+            fprintf(stderr, "%s: request at @%lu is cut short\n", path.c_str(), millis);
+            return false;
+        }
+        requests.push_back({millis, text.substr(position, length)});
+        position += length + 1;
+    }
+    return true;
+}
+
+// "/get" from "GET /get?x=1 HTTP/1.1 ..."
+static std::string requestPath(const std::string& request) {
+    size_t start = request.find(' ');
+    if (start == std::string::npos) {
+        return "(partial)";
+    }
+    size_t end = request.find_first_of(" ?\r\n", start + 1);
+    if (end == std::string::npos) {
+        return "(partial)";
+    }
+    return request.substr(start + 1, end - start - 1);
+}
+
+// loop() until the virtual clock reaches micros, as the board idled
+static void idleUntil(unsigned long until) {
+    while ((long)(micros() - until) < 0) {
+        unsigned long before = micros();
+        loop();
+        if (micros() == before) {
+            hostAdvanceMicros(LOOP_MICROS);
+        }
+    }
+}
+
+static std::map<std::string, SummaryLine> loadSummary(const std::string& path) {
+    std::map<std::string, SummaryLine> summary;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name;
+        SummaryLine values;
+        if (fields >> name >> values.requests >> values.p50 >> values.p99 >> values.allocations >> values.allocatedBytes) {
+            summary[name] = values;
+        }
+    }
+    return summary;
+}
+
+static std::string change(double before, double after) {
+    char text[48];
+    if (before == 0) {
+        snprintf(text, sizeof(text), "%.1f -> %.1f", before, after);
+    } else {
+        double percent = (after - before) * 100.0 / before;
+        snprintf(text, sizeof(text), "%.1f -> %.1f (%+.0f%%)", before, after, fabs(percent) < 0.5 ? 0.0 : percent);
+    }
+    return text;
+}
+
+int main(int argc, char** argv) {
+    int rounds = 1;
+    uint16_t port = 80;
+    std::string capturePath, summaryPath, comparePath;
+    bool strict = false;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--rounds" && i + 1 < argc) {
+            rounds = atoi(argv[++i]);
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = (uint16_t)strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--summary" && i + 1 < argc) {
+            summaryPath = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            comparePath = argv[++i];
+        } else if (arg == "--strict") {
+            strict = true;
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else if (capturePath.empty() && arg[0] != '-') {
+            capturePath = arg;
+        } else {
+            capturePath.clear();
+            break;
+        }
+    }
+    if (capturePath.empty() || rounds < 1) {
+        fprintf(stderr, "usage: %s [--rounds 1] [--port 80] [--summary file] [--compare file] "
+                        "[--strict] [--verbose] capture\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<CapturedRequest> requests;
+    if (!loadCapture(capturePath, requests) || requests.empty()) {
+        fprintf(stderr, "%s: no requests to replay\n", capturePath.c_str());
+        return 1;
+    }
+
+    Serial.setQuiet(!verbose);
+    hostUseVirtualClock();
+    setup();
+
+    std::map<std::string, PathResults> results;
+    PathResults all;
+    for (int round = 0; round < rounds; round++) {
+        unsigned long roundStart = micros();
+        for (const CapturedRequest& request : requests) {
+            idleUntil(roundStart + request.millis * 1000);
+
+            // An emulated link with no latency or bandwidth limit, so a
+            // request that stops short times out on the virtual clock
+            auto connection = WebGUIHost::connect(port, request.bytes, HostLink());
+            connection->tx.reserve(64 * 1024);   // Keeps shim buffer growth out of the counts
+            unsigned long giveUp = micros() + GIVE_UP_MICROS;
+            WebGUIAllocStats before = getAllocStats(WEBGUI_ALLOC_UPDATE);
+            auto start = std::chrono::steady_clock::now();
+            while (!connection->closed && (long)(micros() - giveUp) < 0) {
+                loop();
+                hostAdvanceMicros(LOOP_MICROS);
+            }
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            WebGUIAllocStats after = getAllocStats(WEBGUI_ALLOC_UPDATE);
+
+            PathResults& path = results[requestPath(request.bytes)];
+            for (PathResults* totals : { &path, &all }) {
+                totals->micros.add(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+                totals->allocations += after.allocations - before.allocations;
+                totals->allocatedBytes += after.bytes - before.bytes;
+                if (WebGUIHost::responseStatus(*connection) != 200) {
+                    totals->errors++;
+                }
+            }
+        }
+    }
+
+    printf("WebGUI replay of %s (%s personality, %zu requests, %d round(s))\n\n",
+           capturePath.c_str(), WEBGUI_HOST_PERSONALITY, requests.size(), rounds);
+    printf("%-24s %8s %8s %8s %8s %9s %7s\n", "path", "requests", "p50 us", "p99 us", "allocs", "alloc B", "errors");
+
+    std::map<std::string, SummaryLine> summary;
+    results["(all)"] = all;
+    for (auto& entry : results) {
+        PathResults& path = entry.second;
+        SummaryLine line;
+        line.requests = (unsigned long)path.micros.size();
+        line.p50 = (double)path.micros.percentile(0.5);
+        line.p99 = (double)path.micros.percentile(0.99);
+        line.allocations = (double)path.allocations / line.requests;
+        line.allocatedBytes = (double)path.allocatedBytes / line.requests;
+        summary[entry.first] = line;
+        printf("%-24s %8lu %8.0f %8.0f %8.1f %9.0f %7lu\n", entry.first.c_str(), line.requests,
+               line.p50, line.p99, line.allocations, line.allocatedBytes, path.errors);
+    }
+
+    if (!summaryPath.empty()) {
+        FILE* file = fopen(summaryPath.c_str(), "w");
+        if (!file) {
+            fprintf(stderr, "cannot write %s\n", summaryPath.c_str());
+            return 1;
+        }
+        fprintf(file, "# %s, %s personality, %d round(s)\n", capturePath.c_str(), WEBGUI_HOST_PERSONALITY, rounds);
+        fprintf(file, "# path requests p50_us p99_us allocs alloc_bytes\n");
+        for (auto& entry : summary) {
+            const SummaryLine& line = entry.second;
+            fprintf(file, "%s %lu %.0f %.0f %.2f %.1f\n", entry.first.c_str(), line.requests,
+                    line.p50, line.p99, line.allocations, line.allocatedBytes);
+        }
+        fclose(file);
+    }
+
+    if (!comparePath.empty()) {
+        std::map<std::string, SummaryLine> before = loadSummary(comparePath);
+        if (before.empty()) {
+            fprintf(stderr, "cannot read %s\n", comparePath.c_str());
+            return 1;
+        }
+        printf("\nCompared with %s\n", comparePath.c_str());
+        printf("%-24s %-24s %-24s %s\n", "path", "p50 us", "p99 us", "allocs");
+        for (auto& entry : summary) {
+            auto old = before.find(entry.first);
+            if (old == before.end()) {
+                printf("%-24s (not in %s)\n", entry.first.c_str(), comparePath.c_str());
+                continue;
+            }
+            printf("%-24s %-24s %-24s %s\n", entry.first.c_str(),
+                   change(old->second.p50, entry.second.p50).c_str(),
+                   change(old->second.p99, entry.second.p99).c_str(),
+                   change(old->second.allocations, entry.second.allocations).c_str());
+        }
+    }
+
+    if (strict && all.errors) {
+        printf("\nFAIL: %lu request(s) not answered with 200\n", all.errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+  main.cpp - Runs an Arduino sketch as a Linux process on real sockets
+
+  Calls the sketch's setup() once and loop() forever, as the board's core
+  does, with WiFiServer listening on a localhost TCP port. Open the page in
+  a browser or point curl, wrk or ab at it:
+
+    ./build/sketch_station_save_settings_esp32 --port 8080
+    wrk -t2 -c16 -d10s http://127.0.0.1:8080/get
+
+  Between loop() calls the process sleeps until a connection or request
+  bytes arrive (at most 1 ms), so an idle sketch doesn't hold a core; a
+  board spins instead, which --spin reproduces.
+
+  usage: sketch [--address 127.0.0.1] [--port 8080] [--spin]
+
+  --port replaces the sketch's port 80 (ports below 1024 need root); other
+  ports are used as the sketch gives them.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include <Arduino.h>
+#include <HostNetwork.h>
+#include <string>
+
+void setup();
+void loop();
+
+int main(int argc, char** argv) {
+    std::string address = "127.0.0.1";
+    unsigned long port = 8080;
+    bool spin = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--address" && i + 1 < argc) {
+            address = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--spin") {
+            spin = true;
+        } else {
+            fprintf(stderr, "usage: %s [--address 127.0.0.1] [--port 8080] [--spin]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    WebGUIHost::useSockets(address.c_str());
+    WebGUIHost::mapPort(80, (uint16_t)port);
+    setup();
+    if (WebGUIHost::listeningPort(80)) {
+        fprintf(stderr, "Serving http://%s:%u/\n", address.c_str(), WebGUIHost::listeningPort(80));
+    }
+
+    for (;;) {
+        loop();
+        if (!spin) {
+            WebGUIHost::waitForSockets(1);
+        }
+    }
+}
@@ -0,0 +1,281 @@
+/*
+  Arduino.cpp - String, Print, Serial and IPAddress for the WebGUI host build
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "Arduino.h"
+#include <ctype.h>
+#include <unistd.h>
+
+HostSerial Serial;
+
+// ----------------------------------------------------------------------------
+// Number formatting
+// ----------------------------------------------------------------------------
+
+char* dtostrf(double value, signed char width, unsigned char prec, char* buffer) {
+    sprintf(buffer, "%*.*f", width, prec, value);
+    return buffer;
+}
+
+char* ultoa(unsigned long value, char* buffer, int radix) {
+    char tmp[33];
+    int i = 0;
+    do {
+        int digit = value % radix;
+        tmp[i++] = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= radix;
+    } while (value);
+    int j = 0;
+    while (i) buffer[j++] = tmp[--i];
+    buffer[j] = '\0';
+    return buffer;
+}
+
+char* ltoa(long value, char* buffer, int radix) {
+    if (value < 0 && radix == 10) {
+        buffer[0] = '-';
+        ultoa(-(unsigned long)value, buffer + 1, radix);
+        return buffer;
+    }
+    return ultoa((unsigned long)value, buffer, radix);
+}
+
+char* itoa(int value, char* buffer, int radix) { return ltoa(value, buffer, radix); }
+char* utoa(unsigned value, char* buffer, int radix) { return ultoa(value, buffer, radix); }
+
+// ----------------------------------------------------------------------------
+// String
+// ----------------------------------------------------------------------------
+
+String::String(int value, unsigned char base) : String((long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) {
+    char buf[34];
+    *this = ltoa(value, buf, base);
+}
+
+String::String(unsigned long value, unsigned char base) {
+    char buf[33];
+    *this = ultoa(value, buf, base);
+}
+
+String::String(float value, unsigned char decimals) : String((double)value, decimals) {}
+
+String::String(double value, unsigned char decimals) {
+    char buf[64];
+    *this = dtostrf(value, decimals + 2, decimals, buf);
+}
+
+// Grows the buffer with realloc as the Arduino core does; never shrinks it
+bool String::reserve(unsigned int size) {
+    if (buffer && capacity >= size) {
+        return true;
+    }
+    char* grown = (char*)realloc(buffer, size + 1);
+    if (!grown) {
+        return false;
+    }
+    if (!buffer) {
+        grown[0] = '\0';
+    }
+    buffer = grown;
+    capacity = size;
+    return true;
+}
+
+// The text may point into this String's own buffer
+void String::copy(const char* text, unsigned int length) {
+    if (length == 0) {
+        if (buffer) {
+            buffer[0] = '\0';
+        }
+        len = 0;
+        return;
+    }
+    if (!reserve(length)) {
+        return;
+    }
+    memmove(buffer, text, length);
+    buffer[length] = '\0';
+    len = length;
+}
+
+bool String::concat(const char* other, unsigned int length) {
+    if (length == 0) {
+        return true;
+    }
+    if (other >= buffer && other < buffer + len) {
+        // Appending part of itself: the buffer may move
+        String part(*this);
+        return concat(part.c_str() + (other - buffer), length);
+    }
+    if (!reserve(len + length)) {
+        return false;
+    }
+    memcpy(buffer + len, other, length);
+    len += length;
+    buffer[len] = '\0';
+    return true;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    if (from >= len) return -1;
+    const char* found = (const char*)memchr(buffer + from, c, len - from);
+    return found ? (int)(found - buffer) : -1;
+}
+
+int String::indexOf(const char* str, unsigned int from) const {
+    if (from > len) return -1;
+    const char* found = strstr(c_str() + from, str);
+    return found ? (int)(found - c_str()) : -1;
+}
+
+int String::lastIndexOf(char c) const {
+    for (unsigned int i = len; i-- > 0;) {
+        if (buffer[i] == c) return (int)i;
+    }
+    return -1;
+}
+
+int String::lastIndexOf(const String& str) const {
+    if (str.len > len) return -1;
+    for (unsigned int i = len - str.len + 1; i-- > 0;) {
+        if (memcmp(c_str() + i, str.c_str(), str.len) == 0) return (int)i;
+    }
+    return -1;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) { unsigned int t = from; from = to; to = t; }
+    if (from >= len) return String();
+    if (to > len) to = len;
+    String out;
+    out.copy(buffer + from, to - from);
+    return out;
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find.len == 0 || len == 0) return;
+    String out;
+    unsigned int pos = 0;
+    int found;
+    while ((found = indexOf(find, pos)) >= 0) {
+        out.concat(buffer + pos, found - pos);
+        out.concat(replacement);
+        pos = found + find.len;
+    }
+    if (pos == 0) return;
+    out.concat(buffer + pos, len - pos);
+    *this = std::move(out);
+}
+
+void String::replace(char find, char replacement) {
+    for (unsigned int i = 0; i < len; i++) if (buffer[i] == find) buffer[i] = replacement;
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+    if (index >= len) return;
+    if (count > len - index) count = len - index;
+    memmove(buffer + index, buffer + index + count, len - index - count + 1);
+    len -= count;
+}
+
+void String::toLowerCase() { for (unsigned int i = 0; i < len; i++) buffer[i] = tolower((unsigned char)buffer[i]); }
+void String::toUpperCase() { for (unsigned int i = 0; i < len; i++) buffer[i] = toupper((unsigned char)buffer[i]); }
+
+void String::trim() {
+    unsigned int begin = 0, end = len;
+    while (begin < end && isspace((unsigned char)buffer[begin])) begin++;
+    while (end > begin && isspace((unsigned char)buffer[end - 1])) end--;
+    copy(buffer + begin, end - begin);
+}
+
+// ----------------------------------------------------------------------------
+// Print
+// ----------------------------------------------------------------------------
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::print(long value, int base) {
+    char buf[34];
+    return write(ltoa(value, buf, base));
+}
+
+size_t Print::print(unsigned long value, int base) {
+    char buf[33];
+    return write(ultoa(value, buf, base));
+}
+
+size_t Print::print(double value, int decimals) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+    return write(buf);
+}
+
+size_t HostSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HostSerial::write(const uint8_t* buffer, size_t size) {
+    if (!quiet) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+// ----------------------------------------------------------------------------
+// IPAddress
+// ----------------------------------------------------------------------------
+
+bool IPAddress::fromString(const char* address) {
+    unsigned int parts[4];
+    char tail;
+    if (!address || sscanf(address, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &tail) != 4) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (parts[i] > 255) return false;
+        bytes[i] = parts[i];
+    }
+    return true;
+}
+
+String IPAddress::toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return String(buf);
+}
+
+// ----------------------------------------------------------------------------
+// Platform odds and ends
+// ----------------------------------------------------------------------------
+
+EspClass ESP;
+
+#if defined(ESP32)
+void EspClass::restart() {
+    Serial.println("[host] ESP.restart()");
+    exit(0);
+}
+#else
+void NVIC_SystemReset() {
+    Serial.println("[host] NVIC_SystemReset()");
+    exit(0);
+}
+#endif
+
+uint32_t hostFreeHeap = 300000;
+
+uint32_t EspClass::getFreeHeap() { return hostFreeHeap; }
+uint32_t EspClass::getMinFreeHeap() { return 280000; }
+uint32_t EspClass::getMaxAllocHeap() { return 110000; }
+uint32_t EspClass::getHeapSize() { return 320000; }
+unsigned uxTaskGetStackHighWaterMark(void*) { return 5000; }
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    static thread_local int hostTask;
+    return &hostTask;
+}
@@ -0,0 +1,51 @@
+/*
+  HostClock.cpp - millis()/micros()/delay() for the WebGUI host build
+
+  Real time by default. After hostUseVirtualClock() time stands still
+  until something advances it, so timeouts and link timing come out the
+  same on every run and machine, and a 5 s timeout takes no time to test.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "Arduino.h"
+#include <chrono>
+#include <thread>
+
+static const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+static bool virtualClock = false;
+static unsigned long virtualMicros = 0;
+
+void hostUseVirtualClock(unsigned long startMillis) {
+    virtualClock = true;
+    virtualMicros = startMillis * 1000;
+}
+
+bool hostClockIsVirtual() {
+    return virtualClock;
+}
+
+void hostAdvanceMicros(unsigned long us) {
+    if (virtualClock) {
+        virtualMicros += us;
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+unsigned long micros() {
+    if (virtualClock) return virtualMicros;
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long millis() {
+    return micros() / 1000;
+}
+
+void delay(unsigned long ms) {
+    hostAdvanceMicros(ms * 1000);
+}
+
+void yield() {}
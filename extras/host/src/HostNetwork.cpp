@@ -0,0 +1,435 @@
+/*
+  HostNetwork.cpp - In-memory WiFi, WiFiServer and WiFiClient for the WebGUI host build
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "HostNetwork.h"
+#include <deque>
+#include <map>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <vector>
+
+WiFiClass WiFi;
+
+static std::map<uint16_t, std::deque<std::shared_ptr<HostConnection>>>& pendingConnections() {
+    static std::map<uint16_t, std::deque<std::shared_ptr<HostConnection>>> queues;
+    return queues;
+}
+
+std::shared_ptr<HostConnection> WebGUIHost::connect(uint16_t port, const std::string& request, IPAddress remote) {
+    auto connection = std::make_shared<HostConnection>();
+    connection->port = port;
+    connection->remoteIP = remote;
+    connection->rx = request;
+    pendingConnections()[port].push_back(connection);
+    return connection;
+}
+
+size_t WebGUIHost::pending(uint16_t port) {
+    return pendingConnections()[port].size();
+}
+
+std::string WebGUIHost::responseBody(const HostConnection& connection) {
+    size_t split = connection.tx.find("\r\n\r\n");
+    return split == std::string::npos ? std::string() : connection.tx.substr(split + 4);
+}
+
+int WebGUIHost::responseStatus(const HostConnection& connection) {
+    if (connection.tx.compare(0, 9, "HTTP/1.1 ") != 0) return 0;
+    return atoi(connection.tx.c_str() + 9);
+}
+
+// ----------------------------------------------------------------------------
+// Link emulation
+// ----------------------------------------------------------------------------
+
+// Whether the next segment is lost (xorshift32, so a seed repeats)
+static bool segmentLost(HostConnection& connection) {
+    if (connection.link.loss <= 0) return false;
+    uint32_t& x = connection.lossState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x < connection.link.loss * 4294967296.0;
+}
+
+// Time for bytes [offset, offset + size) of one direction to go out.
+// Worked out from the running total so any split of the same bytes adds
+// up to the same time; every segment boundary crossed may be lost.
+static unsigned long transmitMicros(HostConnection& connection, size_t offset, size_t size) {
+    const HostLink& link = connection.link;
+    unsigned long total = 0;
+    if (link.bytesPerSecond) {
+        total = (unsigned long)(((offset + size) * 1000000ULL) / link.bytesPerSecond -
+                                (offset * 1000000ULL) / link.bytesPerSecond);
+    }
+    size_t segments = (offset + size + link.segmentSize - 1) / link.segmentSize -
+                      (offset + link.segmentSize - 1) / link.segmentSize;
+    for (size_t i = 0; i < segments; i++) {
+        while (segmentLost(connection)) total += link.retransmitMicros;
+    }
+    return total;
+}
+
+std::shared_ptr<HostConnection> WebGUIHost::connect(uint16_t port, const std::string& request, const HostLink& link,
+                                                    IPAddress remote) {
+    auto connection = connect(port, request, remote);
+    connection->emulated = true;
+    connection->link = link;
+    if (connection->link.segmentSize == 0) connection->link.segmentSize = 1;
+    if (connection->link.loss >= 1) connection->link.loss = 0.99f;
+    // Mixed first: xorshift's early outputs from small seeds are small too,
+    // which would lose the first segments of every connection
+    uint32_t state = link.seed;
+    state = (state ^ (state >> 16)) * 0x85ebca6bu;
+    state = (state ^ (state >> 13)) * 0xc2b2ae35u;
+    state ^= state >> 16;
+    connection->lossState = state ? state : 1;
+    connection->peerDone = request.empty();
+    connection->openedMicros = micros();
+    connection->sentMicros = connection->openedMicros;
+    connection->deliveredMicros = connection->openedMicros;
+
+    // SYN, SYN-ACK, then the ACK with the request right behind it
+    connection->acceptMicros = connection->openedMicros + 3 * link.latencyMicros;
+
+    // The request, segment by segment, up to where the client stalls
+    size_t limit = request.size() < link.stallAfter ? request.size() : link.stallAfter;
+    unsigned long at = connection->acceptMicros;
+    for (size_t sent = 0; sent < limit;) {
+        size_t segment = limit - sent < connection->link.segmentSize ? limit - sent : connection->link.segmentSize;
+        at += transmitMicros(*connection, sent, segment);
+        sent += segment;
+        connection->arrivals.push_back(std::make_pair(sent, at));
+    }
+    return connection;
+}
+
+// Request bytes received so far; polling an idle link costs virtual time
+static int emulatedAvailable(HostConnection& connection) {
+    unsigned long now = micros();
+    size_t arrived = 0;
+    for (const auto& arrival : connection.arrivals) {
+        if ((long)(now - arrival.second) < 0) break;
+        arrived = arrival.first;
+    }
+    connection.peerDone = arrived == connection.rx.size();
+    int count = (int)(arrived - connection.rxPos);
+    if (count == 0 && !connection.peerDone && hostClockIsVirtual()) {
+        hostAdvanceMicros(connection.link.pollMicros);
+    }
+    return count;
+}
+
+// Response bytes onto the link; blocks while the send window is full
+static void emulatedSend(HostConnection& connection, size_t size) {
+    const HostLink& link = connection.link;
+    size_t offset = connection.tx.size();
+    while (size > 0) {
+        unsigned long now = micros();
+        while (!connection.unacked.empty() && (long)(now - connection.unacked.front().second) >= 0) {
+            connection.unackedBytes -= connection.unacked.front().first;
+            connection.unacked.pop_front();
+        }
+        if (connection.unackedBytes >= link.sendWindow) {
+            unsigned long wait = connection.unacked.front().second - now;
+            hostAdvanceMicros(wait);
+            connection.blockedMicros += wait;
+            continue;
+        }
+
+        size_t chunk = link.sendWindow - connection.unackedBytes;
+        if (chunk > size) chunk = size;
+        unsigned long start = (long)(connection.sentMicros - now) > 0 ? connection.sentMicros : now;
+        connection.sentMicros = start + transmitMicros(connection, offset, chunk);
+        connection.deliveredMicros = connection.sentMicros + link.latencyMicros;
+        connection.unacked.push_back(std::make_pair(chunk, connection.deliveredMicros + link.latencyMicros));
+        connection.unackedBytes += chunk;
+        offset += chunk;
+        size -= chunk;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Real sockets
+// ----------------------------------------------------------------------------
+
+struct SocketConfig {
+    bool enabled = false;
+    std::string address;
+    std::map<uint16_t, uint16_t> portMap;         // device port -> requested host port
+    std::map<uint16_t, uint16_t> boundPorts;      // device port -> port actually bound
+    std::vector<int> watched;                     // Listening and open sockets
+};
+
+// Never destroyed: the global GUI stops its server from its destructor,
+// which may run after this file's statics are gone
+static SocketConfig& sockets() {
+    static SocketConfig* config = new SocketConfig;
+    return *config;
+}
+
+static void watchSocket(int fd) {
+    sockets().watched.push_back(fd);
+}
+
+static void unwatchSocket(int fd) {
+    std::vector<int>& watched = sockets().watched;
+    for (size_t i = 0; i < watched.size(); i++) {
+        if (watched[i] == fd) {
+            watched.erase(watched.begin() + i);
+            return;
+        }
+    }
+}
+
+void WebGUIHost::useSockets(const char* address) {
+    sockets().enabled = true;
+    sockets().address = address;
+}
+
+void WebGUIHost::mapPort(uint16_t devicePort, uint16_t hostPort) {
+    sockets().portMap[devicePort] = hostPort;
+}
+
+uint16_t WebGUIHost::listeningPort(uint16_t devicePort) {
+    auto bound = sockets().boundPorts.find(devicePort);
+    return bound == sockets().boundPorts.end() ? 0 : bound->second;
+}
+
+void WebGUIHost::waitForSockets(unsigned long timeoutMs) {
+    std::vector<pollfd> fds;
+    for (int fd : sockets().watched) {
+        fds.push_back({ fd, POLLIN, 0 });
+    }
+    poll(fds.data(), fds.size(), (int)timeoutMs);
+}
+
+// Reads whatever the peer has sent so far without waiting
+static void receiveAvailable(HostConnection& connection) {
+    if (connection.peerDone) return;
+    if (connection.rxPos == connection.rx.size()) {
+        connection.rx.clear();
+        connection.rxPos = 0;
+    }
+    char buffer[4096];
+    for (;;) {
+        ssize_t n = recv(connection.socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0) {
+            connection.rx.append(buffer, n);
+            if ((size_t)n < sizeof(buffer)) return;
+        } else {
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                connection.peerDone = true;
+            }
+            return;
+        }
+    }
+}
+
+// Writes all of it, waiting for room as a WiFi module's write() does
+static size_t sendAll(HostConnection& connection, const uint8_t* data, size_t size) {
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(connection.socket, data + sent, size - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd fd = { connection.socket, POLLOUT, 0 };
+            poll(&fd, 1, 1000);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            break;  // Peer went away; the rest is lost as it would be on a board
+        }
+    }
+    return sent;
+}
+
+static void closeSocket(HostConnection& connection) {
+    // Whatever the browser already sent beyond the request (a pipelined
+    // request, a keep-alive probe) is read first: closing with unread data
+    // resets the connection and can cut off the response in flight
+    shutdown(connection.socket, SHUT_WR);
+    char buffer[4096];
+    while (recv(connection.socket, buffer, sizeof(buffer), MSG_DONTWAIT) > 0) {
+    }
+    unwatchSocket(connection.socket);
+    close(connection.socket);
+    connection.socket = -1;
+}
+
+HostConnection::~HostConnection() {
+    if (socket >= 0) closeSocket(*this);
+}
+
+// ----------------------------------------------------------------------------
+// WiFiClient
+// ----------------------------------------------------------------------------
+
+uint8_t WiFiClient::connected() {
+    if (!connection || connection->closed) return 0;
+    return available() > 0 || !connection->peerDone;
+}
+
+int WiFiClient::available() {
+    if (!connection || connection->closed) return 0;
+    if (connection->socket >= 0) receiveAvailable(*connection);
+    if (connection->emulated) return emulatedAvailable(*connection);
+    return (int)(connection->rx.size() - connection->rxPos);
+}
+
+int WiFiClient::read() {
+    if (available() <= 0) return -1;
+    return (uint8_t)connection->rx[connection->rxPos++];
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    int n = available();
+    if (n <= 0) return -1;
+    if ((size_t)n > size) n = (int)size;
+    memcpy(buffer, connection->rx.data() + connection->rxPos, n);
+    connection->rxPos += n;
+    return n;
+}
+
+int WiFiClient::peek() {
+    if (available() <= 0) return -1;
+    return (uint8_t)connection->rx[connection->rxPos];
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (!connection || connection->closed) return 0;
+    if (connection->socket >= 0) return sendAll(*connection, buffer, size);
+    if (connection->emulated) emulatedSend(*connection, size);
+    connection->tx.append((const char*)buffer, size);
+    return size;
+}
+
+void WiFiClient::stop() {
+    if (!connection || connection->closed) return;
+    if (connection->socket >= 0) closeSocket(*connection);
+    connection->closed = true;
+}
+
+// ----------------------------------------------------------------------------
+// WiFiServer
+// ----------------------------------------------------------------------------
+
+void WiFiServer::begin() {
+    listening = true;
+    if (!sockets().enabled || listenSocket >= 0) return;
+
+    auto mapped = sockets().portMap.find(port);
+    uint16_t hostPort = mapped == sockets().portMap.end() ? port : mapped->second;
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(hostPort);
+    if (inet_pton(AF_INET, sockets().address.c_str(), &address.sin_addr) != 1) {
+        fprintf(stderr, "WiFiServer: bad listen address %s\n", sockets().address.c_str());
+        return;
+    }
+
+    listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int on = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (bind(listenSocket, (sockaddr*)&address, sizeof(address)) != 0 || listen(listenSocket, 512) != 0) {
+        fprintf(stderr, "WiFiServer: cannot listen on %s:%u: %s\n",
+                sockets().address.c_str(), hostPort, strerror(errno));
+        close(listenSocket);
+        listenSocket = -1;
+        return;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listenSocket, (sockaddr*)&address, &length);
+    sockets().boundPorts[port] = ntohs(address.sin_port);
+    watchSocket(listenSocket);
+}
+
+void WiFiServer::end() {
+    listening = false;
+    if (listenSocket >= 0) {
+        unwatchSocket(listenSocket);
+        close(listenSocket);
+        sockets().boundPorts.erase(port);
+        listenSocket = -1;
+    }
+}
+
+WiFiClient WiFiServer::available() {
+    if (listenSocket >= 0) {
+        sockaddr_in peer = {};
+        socklen_t length = sizeof(peer);
+        int fd = accept4(listenSocket, (sockaddr*)&peer, &length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return WiFiClient();
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        watchSocket(fd);
+
+        auto connection = std::make_shared<HostConnection>();
+        connection->port = port;
+        connection->socket = fd;
+        connection->peerDone = false;
+        connection->remoteIP = IPAddress(peer.sin_addr.s_addr);
+        return WiFiClient(connection);
+    }
+
+    auto& queue = pendingConnections()[port];
+    if (!listening || queue.empty()) return WiFiClient();
+    if (queue.front()->emulated && (long)(micros() - queue.front()->acceptMicros) < 0) {
+        return WiFiClient();
+    }
+    auto connection = queue.front();
+    queue.pop_front();
+    return WiFiClient(connection);
+}
+
+// ----------------------------------------------------------------------------
+// WiFiClass
+// ----------------------------------------------------------------------------
+
+int WiFiClass::begin(const char* ssid, const char*) {
+    this->ssid = ssid;
+    pollsRemaining = associationPolls;
+    currentStatus = WL_DISCONNECTED;
+    if (staticConfig) ip = staticIP;
+    return currentStatus;
+}
+
+int WiFiClass::beginAP(const char*, const char*) {
+    ip = apIP;
+    currentStatus = WL_CONNECTED;
+    return currentStatus;
+}
+
+bool WiFiClass::softAP(const char*, const char*) {
+    return true;
+}
+
+bool WiFiClass::config(IPAddress ip, IPAddress gateway, IPAddress subnet) {
+    staticConfig = true;
+    staticIP = ip;
+    this->gateway = gateway;
+    this->subnet = subnet;
+    return true;
+}
+
+int WiFiClass::disconnect() {
+    currentStatus = WL_DISCONNECTED;
+    return 1;
+}
+
+uint8_t WiFiClass::status() {
+    if (currentStatus == WL_DISCONNECTED && pollsRemaining > 0 && --pollsRemaining == 0) {
+        currentStatus = WL_CONNECTED;
+    }
+    return currentStatus;
+}
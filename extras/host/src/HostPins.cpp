@@ -0,0 +1,64 @@
+/*
+  HostPins.cpp - Pin I/O and random() for the WebGUI host build
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "Arduino.h"
+
+static const int PIN_COUNT = 64;
+
+static int pinValues[PIN_COUNT];
+static int analogInputs[PIN_COUNT] = {};
+static bool analogInputSet[PIN_COUNT] = {};
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < PIN_COUNT && mode == INPUT_PULLUP) pinValues[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < PIN_COUNT) pinValues[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < PIN_COUNT ? (pinValues[pin] ? HIGH : LOW) : LOW;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    if (pin < PIN_COUNT) pinValues[pin] = value;
+}
+
+int analogRead(uint8_t pin) {
+    if (pin >= PIN_COUNT) return 0;
+    return analogInputSet[pin] ? analogInputs[pin] : 512;
+}
+
+void hostSetAnalogInput(uint8_t pin, int value) {
+    if (pin < PIN_COUNT) {
+        analogInputs[pin] = value;
+        analogInputSet[pin] = true;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// random(): a fixed default seed, so runs repeat unless the sketch reseeds
+// ----------------------------------------------------------------------------
+
+static uint32_t randomState = 1;
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) randomState = (uint32_t)seed;
+}
+
+long random(long max) {
+    if (max <= 0) return 0;
+    // xorshift32
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (long)(randomState % (uint32_t)max);
+}
+
+long random(long min, long max) {
+    return min >= max ? min : min + random(max - min);
+}
@@ -0,0 +1,99 @@
+/*
+  Storage.cpp - Preferences and EEPROM backing stores for the WebGUI host build
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "Preferences.h"
+#include "EEPROM.h"
+#include <map>
+
+EEPROMClass EEPROM;
+
+namespace {
+    struct Value {
+        enum { Int, Float, Bool, Str } type;
+        int32_t i;
+        float f;
+        bool b;
+        std::string s;
+    };
+
+    std::map<std::string, std::map<std::string, Value>>& namespaces() {
+        static std::map<std::string, std::map<std::string, Value>> store;
+        return store;
+    }
+
+    unsigned long preferenceWrites = 0;
+}
+
+bool Preferences::begin(const char* name, bool) {
+    ns = name ? name : "";
+    namespaces()[ns];
+    return true;
+}
+
+bool Preferences::clear() {
+    namespaces()[ns].clear();
+    return true;
+}
+
+unsigned long Preferences::writeCount() {
+    return preferenceWrites;
+}
+
+size_t Preferences::putInt(const char* key, int32_t value) {
+    Value& v = namespaces()[ns][key];
+    v.type = Value::Int;
+    v.i = value;
+    preferenceWrites++;
+    return sizeof(value);
+}
+
+size_t Preferences::putFloat(const char* key, float value) {
+    Value& v = namespaces()[ns][key];
+    v.type = Value::Float;
+    v.f = value;
+    preferenceWrites++;
+    return sizeof(value);
+}
+
+size_t Preferences::putBool(const char* key, bool value) {
+    Value& v = namespaces()[ns][key];
+    v.type = Value::Bool;
+    v.b = value;
+    preferenceWrites++;
+    return sizeof(value);
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+    Value& v = namespaces()[ns][key];
+    v.type = Value::Str;
+    v.s = value ? value : "";
+    preferenceWrites++;
+    return v.s.size();
+}
+
+int32_t Preferences::getInt(const char* key, int32_t defaultValue) {
+    auto& store = namespaces()[ns];
+    auto it = store.find(key);
+    return it != store.end() && it->second.type == Value::Int ? it->second.i : defaultValue;
+}
+
+float Preferences::getFloat(const char* key, float defaultValue) {
+    auto& store = namespaces()[ns];
+    auto it = store.find(key);
+    return it != store.end() && it->second.type == Value::Float ? it->second.f : defaultValue;
+}
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+    auto& store = namespaces()[ns];
+    auto it = store.find(key);
+    return it != store.end() && it->second.type == Value::Bool ? it->second.b : defaultValue;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue) {
+    auto& store = namespaces()[ns];
+    auto it = store.find(key);
+    return it != store.end() && it->second.type == Value::Str ? String(it->second.s.c_str()) : defaultValue;
+}
@@ -0,0 +1,158 @@
+/*
+  WebServer.cpp - Minimal ESP32 WebServer for the WebGUI host build
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebServer.h"
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static String urlDecode(const char* text, size_t length) {
+    String out;
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c == '+') {
+            out += ' ';
+        } else if (c == '%' && i + 2 < length && hexValue(text[i + 1]) >= 0 && hexValue(text[i + 2]) >= 0) {
+            out += (char)(hexValue(text[i + 1]) * 16 + hexValue(text[i + 2]));
+            i += 2;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+String WebServer::arg(const String& name) {
+    for (const Arg& a : currentArgs) {
+        if (a.name == name) return a.value;
+    }
+    return String();
+}
+
+bool WebServer::hasArg(const String& name) {
+    for (const Arg& a : currentArgs) {
+        if (a.name == name) return true;
+    }
+    return false;
+}
+
+bool WebServer::parseRequest(WiFiClient& client) {
+    std::string line;
+    std::string requestLine;
+    bool firstLine = true;
+    unsigned long lastReceived = millis();
+    while (client.connected()) {
+        int c = client.read();
+        if (c < 0) {
+            // The ESP32 core gives up on a silent client after 5 s too
+            if (millis() - lastReceived > 5000) return false;
+            continue;
+        }
+        lastReceived = millis();
+        if (c == '\r') continue;
+        if (c != '\n') {
+            line += (char)c;
+            continue;
+        }
+        if (firstLine) {
+            requestLine = line;
+            firstLine = false;
+        } else if (line.empty()) {
+            break;
+        }
+        line.clear();
+    }
+    if (requestLine.empty()) return false;
+
+    size_t methodEnd = requestLine.find(' ');
+    if (methodEnd == std::string::npos) return false;
+    size_t urlEnd = requestLine.find(' ', methodEnd + 1);
+    std::string url = requestLine.substr(methodEnd + 1, urlEnd == std::string::npos ? std::string::npos : urlEnd - methodEnd - 1);
+
+    currentArgs.clear();
+    size_t query = url.find('?');
+    currentUri = String(url.substr(0, query).c_str());
+    if (query != std::string::npos) {
+        std::string params = url.substr(query + 1);
+        size_t start = 0;
+        while (start <= params.size()) {
+            size_t end = params.find('&', start);
+            if (end == std::string::npos) end = params.size();
+            std::string param = params.substr(start, end - start);
+            if (!param.empty()) {
+                size_t eq = param.find('=');
+                Arg a;
+                a.name = urlDecode(param.c_str(), eq == std::string::npos ? param.size() : eq);
+                if (eq != std::string::npos) a.value = urlDecode(param.c_str() + eq + 1, param.size() - eq - 1);
+                currentArgs.push_back(a);
+            }
+            start = end + 1;
+        }
+    }
+    return true;
+}
+
+void WebServer::handleClient() {
+    WiFiClient client = server.available();
+    if (!client) return;
+
+    currentClient = client;
+    extraHeaders = String();
+    contentLength = CONTENT_LENGTH_UNKNOWN;
+    if (parseRequest(client)) {
+        bool handled = false;
+        for (const Route& route : routes) {
+            if (route.uri == currentUri) {
+                route.handler();
+                handled = true;
+                break;
+            }
+        }
+        if (!handled) {
+            if (notFound) notFound();
+            else send(404, "text/plain", String("Not found: ") + currentUri);
+        }
+    }
+    client.stop();
+    currentClient = WiFiClient();
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool) {
+    extraHeaders += name + ": " + value + "\r\n";
+}
+
+void WebServer::sendHeaders(int code, const char* contentType, size_t length) {
+    String head = String("HTTP/1.1 ") + code + (code == 200 ? " OK" : code == 404 ? " Not Found" : code == 503 ? " Service Unavailable" : " Error") + "\r\n";
+    if (contentType) head += String("Content-Type: ") + contentType + "\r\n";
+    if (length != CONTENT_LENGTH_UNKNOWN) head += String("Content-Length: ") + (unsigned long)length + "\r\n";
+    head += extraHeaders;
+    head += "Connection: close\r\n\r\n";
+    currentClient.print(head);
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+    size_t length = contentLength != CONTENT_LENGTH_UNKNOWN ? contentLength
+                  : (content.length() > 0 || code != 200 ? content.length() : CONTENT_LENGTH_UNKNOWN);
+    sendHeaders(code, contentType, length);
+    if (content.length()) currentClient.write(content.c_str(), content.length());
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content) {
+    send_P(code, contentType, content, strlen(content));
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content, size_t length) {
+    sendHeaders(code, contentType, length);
+    currentClient.write(content, length);
+}
+
+void WebServer::sendContent(const char* content, size_t length) {
+    currentClient.write(content, length);
+}
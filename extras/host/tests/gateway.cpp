@@ -0,0 +1,186 @@
+/*
+  gateway.cpp - End-to-end check of the epoll gateway
+
+  Hundreds of keep-alive clients poll /get through several workers while
+  the main thread runs update(); /set is forwarded to the library and
+  seen by the next /get and by an /events stream.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include <WebGUI.h>
+#include "../gateway/Gateway.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+
+static std::atomic<int> failures{0};
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+static const int CLIENTS = 200;
+static const int REQUESTS_PER_CLIENT = 20;
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+static int connectTo(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout = {5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// One response off a keep-alive connection, framed by Content-Length
+static std::string readResponse(int fd, std::string& pending) {
+    char buffer[8192];
+    for (;;) {
+        size_t headEnd = pending.find("\r\n\r\n");
+        if (headEnd != std::string::npos) {
+            size_t length = pending.find("Content-Length: ");
+            size_t bodyLength = length < headEnd ? strtoul(pending.c_str() + length + 16, nullptr, 10) : 0;
+            if (pending.size() >= headEnd + 4 + bodyLength) {
+                std::string response = pending.substr(0, headEnd + 4 + bodyLength);
+                pending.erase(0, response.size());
+                return response;
+            }
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return std::string();
+        pending.append(buffer, n);
+    }
+}
+
+static std::string request(int fd, std::string& pending, const std::string& path) {
+    std::string text = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    send(fd, text.data(), text.size(), MSG_NOSIGNAL);
+    return readResponse(fd, pending);
+}
+
+static int status(const std::string& response) {
+    return response.compare(0, 9, "HTTP/1.1 ") == 0 ? atoi(response.c_str() + 9) : 0;
+}
+
+Slider slider("Speed", 10, 10, 0, 100, 50);
+
+int main() {
+    Serial.setQuiet(true);
+    GUI.addElement(&slider);
+    GUI.setTitle("Gateway Test");
+    GUI.startAP("WebGUI-Host");
+    GUI.begin();
+
+    WebGUIGateway gateway;
+    GatewayOptions options;
+    options.port = 0;
+    options.workers = 4;
+    options.refreshMs = 20;
+    CHECK(gateway.start(options));
+    uint16_t port = gateway.port();
+    std::string sliderValue = std::string("\"") + slider.getIDCStr() + "\":\"";
+
+    std::atomic<bool> clientsDone{false};
+    std::thread clients([&] {
+        // Polling clients, all connected at once, each on one connection
+        std::vector<int> fds;
+        std::vector<std::string> pending(CLIENTS);
+        for (int i = 0; i < CLIENTS; i++) fds.push_back(connectTo(port));
+        for (int round = 0; round < REQUESTS_PER_CLIENT; round++) {
+            for (int i = 0; i < CLIENTS; i++) {
+                std::string response = request(fds[i], pending[i], "/get");
+                CHECK(status(response) == 200);
+                CHECK(contains(response, "Connection: keep-alive"));
+                CHECK(contains(response, sliderValue));
+            }
+        }
+        for (int fd : fds) close(fd);
+
+        // The page comes from the snapshot too
+        std::string leftover;
+        int fd = connectTo(port);
+        std::string page = request(fd, leftover, "/");
+        CHECK(status(page) == 200);
+        CHECK(contains(page, "Gateway Test"));
+        CHECK(contains(page, "</html>"));
+
+        // An /events stream opens with the current values
+        int events = connectTo(port);
+        std::string stream = "GET /events HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        send(events, stream.data(), stream.size(), MSG_NOSIGNAL);
+        std::string received;
+        char buffer[4096];
+        while (!contains(received, "data: ")) {
+            ssize_t n = recv(events, buffer, sizeof(buffer), 0);
+            if (n <= 0) break;
+            received.append(buffer, n);
+        }
+        CHECK(contains(received, "text/event-stream"));
+        CHECK(contains(received, sliderValue + "50\""));
+
+        // /set goes through the library and the next /get already has it
+        std::string set = request(fd, leftover, std::string("/set?") + slider.getIDCStr() + "=80");
+        CHECK(status(set) == 200);
+        CHECK(contains(set, "Connection: keep-alive"));
+        CHECK(contains(request(fd, leftover, "/get"), sliderValue + "80\""));
+        // Unknown routes are the library's to answer (404 on ESP32, the page elsewhere)
+        CHECK(status(request(fd, leftover, "/no-such-route")) != 0);
+        close(fd);
+
+        // ... and is pushed to the stream
+        while (!contains(received, sliderValue + "80\"")) {
+            ssize_t n = recv(events, buffer, sizeof(buffer), 0);
+            if (n <= 0) break;
+            received.append(buffer, n);
+        }
+        CHECK(contains(received, sliderValue + "80\""));
+        close(events);
+        clientsDone = true;
+    });
+
+    // The main thread is the sketch's: loop() and the gateway's poll()
+    while (!clientsDone) {
+        GUI.update();
+        gateway.poll(1);
+    }
+    clients.join();
+
+    GatewayStats stats = gateway.stats();
+    CHECK(stats.snapshotResponses >= (unsigned long long)CLIENTS * REQUESTS_PER_CLIENT);
+    CHECK(stats.forwardedRequests == 2);
+#if WEBGUI_TRACE_SIZE > 0
+    // Snapshots are rendered, not requested: the library traced the
+    // forwarded /set but none of the /get refreshes
+    CHECK(GUI.getTrace().size() > 0);
+    for (size_t i = 0; i < GUI.getTrace().size(); i++) {
+        CHECK(GUI.getTrace().get(i).route != WEBGUI_ROUTE_GET);
+    }
+#endif
+    CHECK(slider.getIntValue() == 80);
+    gateway.stop();
+
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures.load());
+        return 1;
+    }
+    printf("gateway test passed (%llu snapshot responses, %llu snapshots)\n",
+           stats.snapshotResponses, stats.snapshots);
+    return 0;
+}
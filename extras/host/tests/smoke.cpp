@@ -0,0 +1,227 @@
+/*
+  smoke.cpp - End-to-end check of one WebGUI personality on the host
+
+  Serves a page, polls /get, drives /set, round-trips persistent settings
+  and checks load shedding, all through the in-memory network.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include <WebGUI.h>
+#include <string>
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+// One request on its own connection, served by a single update()
+static std::shared_ptr<HostConnection> request(const std::string& path) {
+    auto connection = WebGUIHost::connect(80, "GET " + path + " HTTP/1.1\r\nHost: webgui\r\n\r\n");
+    GUI.update();
+    return connection;
+}
+
+Button button("Press", 10, 10);
+Toggle toggle("Power", 10, 60);
+Slider slider("Speed", 10, 110, 0, 100, 50);
+SensorStatus sensor("Temperature", 10, 160);
+TextBox textBox("Name", 10, 210, 200, "Type here");
+
+int main() {
+    Serial.setQuiet(true);
+    
+    GUI.addElement(&button);
+    GUI.addElement(&toggle);
+    GUI.addElement(&slider);
+    GUI.addElement(&sensor);
+    GUI.addElement(&textBox);
+    GUI.setTitle("Smoke Test");
+    
+    // Startup as a sketch does it: join the network, open settings, serve
+    WiFi.setAssociationPolls(3);
+    CHECK(GUI.connectWiFi("HostNet", "secret"));
+    GUI.initSettings();
+    GUI.startAP("WebGUI-Host");
+    GUI.begin();
+    
+    // Page
+    auto page = request("/");
+    CHECK(WebGUIHost::responseStatus(*page) == 200);
+    std::string html = WebGUIHost::responseBody(*page);
+    CHECK(contains(html, "Smoke Test"));
+    CHECK(contains(html, slider.getIDCStr()));
+    CHECK(contains(html, "Type here"));
+    CHECK(page->closed);
+    
+    // The default theme sends no variable block; another one does
+    CHECK(!contains(html, ":root{"));
+    GUI.setTheme(WebGUITheme("#e91e63", "#607d8b", "#fafafa"));
+    std::string themed = WebGUIHost::responseBody(*request("/"));
+    CHECK(contains(themed, ":root{--webgui-primary:#e91e63;"));
+    CHECK(contains(themed, "body{background:#fafafa;}"));
+    GUI.useDefaultStyles();
+    
+    // Values
+    sensor.setValue(21.5f, 1);
+    auto get = request("/get");
+    CHECK(WebGUIHost::responseStatus(*get) == 200);
+    std::string json = WebGUIHost::responseBody(*get);
+    CHECK(contains(json, std::string("\"") + slider.getIDCStr() + "\":\"50\""));
+    CHECK(contains(json, "21.5"));
+    
+    // Updates, with URL decoding
+    std::string set = std::string("/set?") + slider.getIDCStr() + "=75&" + toggle.getIDCStr() + "=1&" +
+                      textBox.getIDCStr() + "=hello%20host";
+    CHECK(WebGUIHost::responseStatus(*request(set)) == 200);
+    CHECK(slider.getIntValue() == 75);
+    CHECK(toggle.isOn());
+    CHECK(textBox.getValue() == "hello host");
+    CHECK(WebGUIHost::responseStatus(*request(std::string("/set?") + button.getIDCStr() + "=1")) == 200);
+    CHECK(button.wasPressed());
+    
+    // Persistent settings
+    GUI.saveSetting("speed", 42);
+    GUI.saveSetting("gain", 1.5f);
+    GUI.saveSetting("enabled", true);
+    GUI.saveSetting("name", "host");
+    CHECK(GUI.loadIntSetting("speed") == 42);
+    CHECK(GUI.loadFloatSetting("gain") == 1.5f);
+    CHECK(GUI.loadBoolSetting("enabled"));
+    CHECK(GUI.loadStringSetting("name") == "host");
+    
+#if !defined(ESP32) && !defined(ARDUINO_SAMD_NANO_33_IOT)
+    // clearMemory() reaches the bool slots
+    GUI.clearMemory();
+    CHECK(!GUI.loadBoolSetting("enabled"));
+#endif
+    
+#if WEBGUI_METRICS
+    auto metrics = request("/metrics");
+    CHECK(WebGUIHost::responseStatus(*metrics) == 200);
+    CHECK(contains(WebGUIHost::responseBody(*metrics), "webgui_requests_total{route=\"set\"} 2"));
+    CHECK(contains(WebGUIHost::responseBody(*metrics), "webgui_active_connections 1\r\n"));  // The /metrics request
+    
+    // Bucket bounds are inclusive, as Prometheus reads le
+    WebGUIHistogram histogram;
+    histogram.add(4);
+    CHECK(histogram.percentile(1.0f) == 4);
+    histogram.add(5);
+    CHECK(histogram.percentile(1.0f) == 8);
+#endif
+    
+#if WEBGUI_TRACE_SIZE > 0
+    auto trace = request("/debug/trace");
+    CHECK(WebGUIHost::responseStatus(*trace) == 200);
+    CHECK(contains(WebGUIHost::responseBody(*trace), "192.168.4.2"));
+    CHECK(GUI.getTrace().size() > 0);
+    CHECK(GUI.getTrace().get(GUI.getTrace().size() - 1).route == WEBGUI_ROUTE_TRACE);
+#endif
+    
+#if WEBGUI_BOOT_TIMELINE_SIZE > 0
+    // Phases in the order they ran; the first page ended startup
+    const WebGUIBootTimeline& boot = GUI.getBootTimeline();
+    CHECK(boot.size() == 6);
+    CHECK(boot.get(0).phase == WEBGUI_BOOT_RADIO);
+    CHECK(boot.get(1).phase == WEBGUI_BOOT_ASSOCIATE);
+    CHECK(boot.get(1).durationMillis >= WEBGUI_WIFI_POLL_MS);
+    CHECK(boot.get(2).phase == WEBGUI_BOOT_DHCP);
+    CHECK(boot.get(5).phase == WEBGUI_BOOT_SERVER);
+    CHECK(boot.isReady());
+    CHECK(boot.getReadyMillis() >= boot.get(5).startMillis);
+    auto bootReport = request("/debug/boot");
+    CHECK(WebGUIHost::responseStatus(*bootReport) == 200);
+    CHECK(contains(WebGUIHost::responseBody(*bootReport), "associate"));
+    CHECK(contains(WebGUIHost::responseBody(*bootReport), "settings reads before ready: 0"));
+#endif
+    
+#if WEBGUI_CAPTURE_SIZE > 0
+    // Requests are recorded as sent once capture starts; /debug/capture
+    // itself is left out and ?stop ends it
+    GUI.startCapture();
+    request("/get");
+    request(std::string("/set?") + slider.getIDCStr() + "=42");
+    auto captured = request("/debug/capture?stop");
+    std::string capture = WebGUIHost::responseBody(*captured);
+    CHECK(WebGUIHost::responseStatus(*captured) == 200);
+    CHECK(GUI.getCapture().size() == 2);
+    CHECK(contains(capture, "# webgui-capture 1\n"));
+    CHECK(contains(capture, "running no\n# requests 2 dropped 0 truncated 0\n@"));
+    CHECK(contains(capture, "GET /get HTTP/1.1\r\n"));
+    CHECK(contains(capture, std::string("GET /set?") + slider.getIDCStr() + "=42 HTTP/1.1\r\n"));
+    CHECK(!contains(capture, "/debug/capture"));
+    request("/get");
+    CHECK(GUI.getCapture().size() == 2);
+    
+    // A full ring makes room by dropping the oldest requests
+    GUI.startCapture();
+    std::string padding(WEBGUI_CAPTURE_SIZE / 3, 'x');
+    for (int i = 0; i < 4; i++) {
+        request("/get?pad=" + padding);
+    }
+    CHECK(GUI.getCapture().size() < 4);
+    CHECK(GUI.getCapture().getDropped() == 4 - GUI.getCapture().size());
+    CHECK(GUI.getCapture().getBytesUsed() <= WEBGUI_CAPTURE_SIZE);
+    GUI.stopCapture();
+    GUI.clearCapture();
+    CHECK(GUI.getCapture().size() == 0);
+#endif
+    
+#if WEBGUI_BYTE_STATS
+    // Every body byte of a page and a /get is attributed to some part
+    GUI.resetByteStats();
+    auto countedPage = request("/");
+    auto countedValues = request("/get");
+    uint32_t attributed = 0;
+    for (int part = 0; part < WEBGUI_BYTES_PARTS; part++) {
+        attributed += GUI.getByteStats().get((WebGUIBytesPart)part);
+    }
+    size_t bodies = WebGUIHost::responseBody(*countedPage).size() + WebGUIHost::responseBody(*countedValues).size();
+    CHECK(attributed == bodies - 2);  // Less the CRLF after the /get JSON
+    CHECK(GUI.getByteStats().get(WEBGUI_BYTES_CSS) > 0);
+#endif
+    
+    // Load shedding: pages are refused, values keep flowing
+    hostFreeHeap = WEBGUI_SHED_PAGES_BELOW - 1;
+    CHECK(WebGUIHost::responseStatus(*request("/")) == 503);
+    CHECK(WebGUIHost::responseStatus(*request("/get")) == 200);
+    CHECK(GUI.isSheddingLoad());
+    hostFreeHeap = 300000;
+    CHECK(WebGUIHost::responseStatus(*request("/")) == 200);
+    
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+    // Shedding messages were queued while serving; idle update() calls send
+    // them, as much per call as Serial reports room for, and a bounded
+    // chunk when it reports none
+    auto log = request("/debug/log");
+    CHECK(contains(WebGUIHost::responseBody(*log), "page requests paused"));
+    CHECK(webguiLog.pending() > 0);
+    Serial.setWriteRoom(0);
+    size_t queued = webguiLog.pending();
+    GUI.update();
+    CHECK(queued - webguiLog.pending() == (queued < WEBGUI_LOG_DRAIN_CHUNK ? queued : WEBGUI_LOG_DRAIN_CHUNK));
+    for (int i = 0; i < 10 && webguiLog.pending() > 0; i++) {
+        GUI.update();
+    }
+    CHECK(webguiLog.pending() == 0);
+    Serial.setWriteRoom(64);
+#endif
+    
+    CHECK(getHeapViolations() == 0);
+    
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("smoke test passed\n");
+    return 0;
+}
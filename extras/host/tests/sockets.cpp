@@ -0,0 +1,117 @@
+/*
+  sockets.cpp - End-to-end check of one WebGUI personality over real TCP
+
+  Serves the page, /get and /set to a client on a localhost socket, the
+  way a browser reaches a sketch run with sketch/main.cpp.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include <WebGUI.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+// Sends one request, lets update() serve it, and reads until the server closes
+static std::string fetch(uint16_t port, const std::string& path) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return std::string();
+    }
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\nConnection: keep-alive\r\n\r\n";
+    send(fd, request.data(), request.size(), 0);
+
+    // The request is already in the socket buffer, so one update() normally
+    // serves it; stop once the response (or the close) has arrived
+    for (int i = 0; i < 100; i++) {
+        GUI.update();
+        char probe;
+        if (recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT) >= 0) break;
+        WebGUIHost::waitForSockets(10);
+    }
+
+    std::string response;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, n);
+    }
+    close(fd);
+    return response;
+}
+
+static int status(const std::string& response) {
+    return response.compare(0, 9, "HTTP/1.1 ") == 0 ? atoi(response.c_str() + 9) : 0;
+}
+
+Slider slider("Speed", 10, 10, 0, 100, 50);
+TextBox textBox("Name", 10, 60, 200, "Type here");
+
+int main() {
+    Serial.setQuiet(true);
+    WebGUIHost::useSockets("127.0.0.1");
+    WebGUIHost::mapPort(80, 0);
+
+    GUI.addElement(&slider);
+    GUI.addElement(&textBox);
+    GUI.setTitle("Socket Test");
+    GUI.startAP("WebGUI-Host");
+    GUI.begin();
+
+    uint16_t port = WebGUIHost::listeningPort(80);
+    CHECK(port != 0);
+
+    std::string page = fetch(port, "/");
+    CHECK(status(page) == 200);
+    CHECK(contains(page, "Socket Test"));
+    CHECK(contains(page, "</html>"));
+
+    std::string set = fetch(port, std::string("/set?") + slider.getIDCStr() + "=80&" +
+                                  textBox.getIDCStr() + "=over%20tcp");
+    CHECK(status(set) == 200);
+    CHECK(slider.getIntValue() == 80);
+    CHECK(textBox.getValue() == "over tcp");
+
+    std::string values = fetch(port, "/get");
+    CHECK(status(values) == 200);
+    CHECK(contains(values, std::string("\"") + slider.getIDCStr() + "\":\"80\""));
+
+    // A client that connects and hangs up without a request
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    CHECK(connect(fd, (sockaddr*)&address, sizeof(address)) == 0);
+    close(fd);
+    GUI.update();
+    CHECK(status(fetch(port, "/get")) == 200);
+
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("socket test passed\n");
+    return 0;
+}
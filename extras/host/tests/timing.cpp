@@ -0,0 +1,145 @@
+/*
+  timing.cpp - Timing behaviour of one WebGUI personality on a virtual clock
+
+  Button press times, the request timeout for a stalled client, a slow
+  client that never goes quiet for long, and a response blocking update()
+  on a slow link. Every figure is virtual time, so the checks are exact
+  and the 5 s timeouts cost nothing.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include <WebGUI.h>
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (0)
+
+// How long a silent client is waited for: the library's own parser, or the
+// ESP32 WebServer stand-in's, which follows the ESP32 core
+#if defined(ESP32) && !WEBGUI_ZERO_HEAP
+static const unsigned long REQUEST_TIMEOUT_MS = 5000;
+#else
+static const unsigned long REQUEST_TIMEOUT_MS = WEBGUI_REQUEST_TIMEOUT_MS;
+#endif
+
+Button button("Go", 10, 10);
+Slider slider("Speed", 10, 60, 0, 100, 50);
+
+// update() as a sketch's loop() calls it, until the connection is served
+static void serve(const std::shared_ptr<HostConnection>& connection) {
+    while (!connection->closed) {
+        GUI.update();
+        hostAdvanceMicros(100);
+    }
+}
+
+// A page load over a slow, lossy link from a fixed start time
+static std::shared_ptr<HostConnection> slowPageLoad(float loss) {
+    hostUseVirtualClock(100000);
+    HostLink link;
+    link.latencyMicros = 20000;
+    link.bytesPerSecond = 20000;
+    link.sendWindow = 2920;    // Two segments, about what the UNO R4 and NINA modules buffer
+    link.loss = loss;
+    link.seed = 7;
+    auto connection = WebGUIHost::connect(80, "GET / HTTP/1.1\r\nHost: webgui\r\n\r\n", link);
+    serve(connection);
+    return connection;
+}
+
+int main() {
+    Serial.setQuiet(true);
+    hostUseVirtualClock(1000);
+    CHECK(hostClockIsVirtual());
+    CHECK(millis() == 1000);
+    delay(250);
+    CHECK(millis() == 1250);
+    CHECK(micros() == 1250000);
+
+    GUI.addElement(&button);
+    GUI.addElement(&slider);
+    GUI.startAP("WebGUI-Host");
+    GUI.begin();
+
+    // Presses are stamped with the virtual time they were served at
+    unsigned long pressAt = millis();
+    auto press = WebGUIHost::connect(80, std::string("GET /set?") + button.getIDCStr() + "=1 HTTP/1.1\r\n\r\n");
+    GUI.update();
+    CHECK(WebGUIHost::responseStatus(*press) == 200);
+    CHECK(button.getLastPressTime() == pressAt);
+    delay(500);
+    press = WebGUIHost::connect(80, std::string("GET /set?") + button.getIDCStr() + "=1 HTTP/1.1\r\n\r\n");
+    GUI.update();
+    CHECK(button.getLastPressTime() == pressAt + 500);
+
+    // A client that sends part of its request line and goes silent holds
+    // update() for exactly the timeout, then is dropped unanswered
+    HostLink stalled;
+    stalled.stallAfter = 8;
+    unsigned long start = millis();
+    auto silent = WebGUIHost::connect(80, "GET /get HTTP/1.1\r\n\r\n", stalled);
+    GUI.update();
+    unsigned long waited = millis() - start;
+    CHECK(silent->closed);
+    CHECK(WebGUIHost::responseStatus(*silent) == 0);
+    CHECK(waited >= REQUEST_TIMEOUT_MS && waited <= REQUEST_TIMEOUT_MS + 1);
+
+    // A slower client is served however long the whole request takes, as
+    // long as no gap reaches the timeout: 5 bytes a second, one at a time
+    HostLink trickle;
+    trickle.bytesPerSecond = 5;
+    trickle.segmentSize = 1;
+    std::string request = std::string("GET /set?") + slider.getIDCStr() + "=77 HTTP/1.1\r\n\r\n";
+    start = millis();
+    auto slow = WebGUIHost::connect(80, request, trickle);
+    GUI.update();
+    CHECK(WebGUIHost::responseStatus(*slow) == 200);
+    CHECK(slider.getIntValue() == 77);
+    CHECK(millis() - start >= request.size() * 1000 / 5 - 1);
+    CHECK(millis() - start > REQUEST_TIMEOUT_MS);
+
+    // Nothing to accept until the handshake is done
+    HostLink distant;
+    distant.latencyMicros = 30000;
+    auto early = WebGUIHost::connect(80, "GET /get HTTP/1.1\r\n\r\n", distant);
+    GUI.update();
+    CHECK(!early->closed && WebGUIHost::pending(80) == 1);
+    serve(early);
+    CHECK(WebGUIHost::responseStatus(*early) == 200);
+    CHECK(early->deliveredMicros - early->openedMicros >= 4 * 30000);
+
+    // On a 20 kB/s link the page overruns the send window and update() blocks
+    // until the client has acknowledged enough of it
+    auto page = slowPageLoad(0);
+    CHECK(WebGUIHost::responseStatus(*page) == 200);
+    size_t pageBytes = page->tx.size();
+    CHECK(pageBytes > page->link.sendWindow);
+    CHECK(page->blockedMicros > 0);
+    CHECK(page->deliveredMicros - page->openedMicros >= pageBytes * 1000000ULL / 20000);
+
+    // Same link, same seed, same numbers; loss only ever makes it slower
+    auto again = slowPageLoad(0);
+    CHECK(again->tx.size() == pageBytes);
+    CHECK(again->deliveredMicros == page->deliveredMicros);
+    CHECK(again->blockedMicros == page->blockedMicros);
+    auto lossy = slowPageLoad(0.25f);
+    auto lossyAgain = slowPageLoad(0.25f);
+    CHECK(lossy->deliveredMicros > page->deliveredMicros);
+    CHECK(lossyAgain->deliveredMicros == lossy->deliveredMicros);
+
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("timing test passed (page %zu bytes: %lu ms to deliver, update() blocked %lu ms; %lu ms with 25%% loss)\n",
+           pageBytes, (page->deliveredMicros - page->openedMicros) / 1000, page->blockedMicros / 1000,
+           (lossy->deliveredMicros - lossy->openedMicros) / 1000);
+    return 0;
+}
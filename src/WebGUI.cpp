@@ -5,6 +5,7 @@
 */
 
 #include "WebGUI.h"
+#include "WebGUIResponse.h"
 
 // Platform-specific includes for settings
 #if defined(ARDUINO_UNOWIFIR4)
@@ -81,7 +82,7 @@ const char TOGGLE_TEMPLATE[] PROGMEM = R"rawliteral(
         <div class="webgui-toggle-container">
             <label class="webgui-toggle-label">%LABEL%</label>
             <label class="webgui-toggle-switch">
-                <input type="checkbox" id="%ID%" class="webgui-toggle-input" onchange="toggleChange('%ID%', this.checked)">
+                <input type="checkbox"%CHECKED% id="%ID%" class="webgui-toggle-input" onchange="toggleChange('%ID%', this.checked)">
                 <span class="webgui-toggle-slider"></span>
             </label>
         </div>
@@ -94,6 +95,88 @@ const char TEXTBOX_TEMPLATE[] PROGMEM = R"rawliteral(
         </div>
 )rawliteral";
 
+// Client-side runtime for the full page template (ESP32)
+const char JS_RUNTIME[] PROGMEM = R"rawliteral(
+        // Button state tracking
+        var buttonStates = {};
+        
+        function updateValue(id, val) {
+            fetch('/set?' + id + '=' + val).catch(e => console.log('Error:', e));
+        }
+        
+        function buttonClick(id) {
+            fetch('/set?' + id + '=1');
+        }
+        
+        function toggleChange(id, checked) {
+            fetch('/set?' + id + '=' + (checked ? 'true' : 'false'));
+        }
+        
+        function textboxChange(id, value) {
+            fetch('/set?' + id + '=' + encodeURIComponent(value));
+        }
+        
+        // Initialize button states on page load
+        function initializeButtonStates() {
+            // Set all buttons to inactive state initially
+            var buttons = document.querySelectorAll('.webgui-button');
+            buttons.forEach(function(button) {
+                buttonStates[button.id] = false;
+                button.classList.add('webgui-button-inactive');
+            });
+        }
+        
+        // Call initialization when page loads
+        document.addEventListener('DOMContentLoaded', initializeButtonStates);
+        
+        // Original immediate slider function (for backward compatibility)
+        function sliderChange(id, value) {
+            document.getElementById(id + '_value').textContent = value;
+            fetch('/set?' + id + '=' + value);
+        }
+        
+        // New debounced slider function
+        function debouncedSliderChange(id, value, debounceMs) {
+            // Update display immediately for responsiveness
+            document.getElementById(id + '_value').textContent = value;
+            
+            // Clear existing timeout for this slider
+            if (window['timeout_' + id]) {
+                clearTimeout(window['timeout_' + id]);
+            }
+            
+            // Set new timeout for network request
+            window['timeout_' + id] = setTimeout(() => {
+                fetch('/set?' + id + '=' + value);
+            }, debounceMs);
+        }
+        
+        // Auto-update function for SensorStatus displays
+        function updateSensorDisplays() {
+            fetch('/get').then(response => response.json()).then(data => {
+                for (let elementId in data) {
+                    let displayElement = document.getElementById(elementId + '_display');
+                    if (displayElement) {
+                        displayElement.textContent = data[elementId];
+                    }
+                    let toggleElement = document.getElementById(elementId);
+                    if (toggleElement && toggleElement.type === 'checkbox') {
+                        let shouldBeChecked = (data[elementId] === 'true' || data[elementId] === '1');
+                        if (toggleElement.checked !== shouldBeChecked) {
+                            toggleElement.checked = shouldBeChecked;
+                        }
+                    }
+                }
+            }).catch(error => {
+                console.error('Update failed:', error);
+            });
+        }
+        
+        // Start auto-updating sensor displays every 100ms
+        setInterval(updateSensorDisplays, 100);
+        updateSensorDisplays();
+    )rawliteral";
+
 const char SYSTEM_STATUS_TEMPLATE[] PROGMEM = R"rawliteral(
         <div class="webgui-system-container">
             <label class="webgui-system-label">%LABEL%</label>
@@ -102,12 +185,16 @@ const char SYSTEM_STATUS_TEMPLATE[] PROGMEM = R"rawliteral(
 )rawliteral";
 
 // WebGUI Implementation
-WebGUI::WebGUI(int port) : serverPort(port), apMode(false), useCustomStyles(false), 
+WebGUI::WebGUI(int port) : serverPort(port), apMode(false), 
+                           loadShedLevel(SHED_NONE), shedPageRequests(0), refusedConnections(0),
+                           countingBytes(true), updateRoute(WEBGUI_ROUTE_NONE), slowUpdateThreshold(0), slowUpdateCallback(nullptr),
                            pageTitle("Arduino WebGUI"), pageHeading("Control Panel"),
                            settingsInitialized(false) {
 #if defined(ESP32)
-    server = new WebServer(port);
     preferences = nullptr;
+#endif
+#if WEBGUI_USE_WEBSERVER
+    server = new WebServer(port);
 #else
     server = new WiFiServer(port);
 #endif
@@ -124,28 +211,106 @@ WebGUI::~WebGUI() {
 }
 
 void WebGUI::begin() {
-#if defined(ESP32)
+    unsigned long phaseStart = millis();
+#if WEBGUI_USE_WEBSERVER
     setupRoutes();
 #endif
     server->begin();
-    Serial.println("WebGUI server started on port " + String(serverPort));
+    initMemoryStats();
+    boot.record(WEBGUI_BOOT_SERVER, phaseStart);
+    WEBGUI_LOG_INFO("WebGUI server started on port ", serverPort);
 }
 
 void WebGUI::update() {
-#if defined(ESP32)
-    server->handleClient();
+    unsigned long startTime = micros();
+    updateRoute = WEBGUI_ROUTE_NONE;
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+    webguiLog.setDeferred(true);  // Messages logged while serving wait in RAM
+#endif
+    {
+        WebGUIHeapGuard heapGuard;
+        WebGUIAllocScope allocScope(WEBGUI_ALLOC_UPDATE);
+        updateLoadShedding();
+#if WEBGUI_USE_WEBSERVER
+        // Under SHED_CONNECTIONS new connections stay in the TCP backlog
+        // until memory recovers
+        if (loadShedLevel != SHED_CONNECTIONS) {
+            server->handleClient();
+        }
 #else
-    processClient();
+        processClient();
 #endif
+    }
+    
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+    // Idle calls pass queued messages on, as much as the output takes
+    // without blocking
+    if (updateRoute == WEBGUI_ROUTE_NONE) {
+        webguiLog.drain();
+    }
+    webguiLog.setDeferred(false);
+#endif
+    
+    // Every call is timed, so the histogram shows how long the sketch's
+    // loop can be held up by web traffic
+    uint32_t elapsed = micros() - startTime;
+    updateTimes.add(elapsed);
+    if (slowUpdateCallback && elapsed > slowUpdateThreshold) {
+        slowUpdateCallback(elapsed, updateRoute);
+    }
 }
 
-void WebGUI::addElement(GUIElement* element) {
-    elements.push_back(element);
+void WebGUI::onSlowUpdate(uint32_t thresholdMicros, WebGUISlowUpdateCallback callback) {
+    slowUpdateThreshold = thresholdMicros;
+    slowUpdateCallback = callback;
+}
+
+// Moves between normal service, page shedding and refusing connections as
+// free heap crosses the configured thresholds. Each level is left only once
+// the heap is WEBGUI_SHED_HYSTERESIS above the threshold that entered it.
+void WebGUI::updateLoadShedding() {
+    uint32_t freeHeap = getFreeHeap();
+    LoadShedLevel level = loadShedLevel;
+    
+    if (level == SHED_CONNECTIONS && freeHeap >= (uint32_t)WEBGUI_REFUSE_CONNECTIONS_BELOW + WEBGUI_SHED_HYSTERESIS) {
+        level = SHED_PAGES;
+    }
+    if (level == SHED_PAGES && freeHeap >= (uint32_t)WEBGUI_SHED_PAGES_BELOW + WEBGUI_SHED_HYSTERESIS) {
+        level = SHED_NONE;
+    }
+    if (WEBGUI_SHED_PAGES_BELOW > 0 && freeHeap < WEBGUI_SHED_PAGES_BELOW && level == SHED_NONE) {
+        level = SHED_PAGES;
+    }
+    if (WEBGUI_REFUSE_CONNECTIONS_BELOW > 0 && freeHeap < WEBGUI_REFUSE_CONNECTIONS_BELOW) {
+        level = SHED_CONNECTIONS;
+    }
+    
+    if (level != loadShedLevel) {
+        loadShedLevel = level;
+        WEBGUI_LOG_WARN("WebGUI: free heap ", freeHeap,
+                        level == SHED_NONE ? " bytes, normal service resumed" :
+                        level == SHED_PAGES ? " bytes, page requests paused" :
+                                              " bytes, new connections paused");
+    }
+}
+
+bool WebGUI::addElement(GUIElement* element) {
+    if (element->getIDCStr()[0] == '\0') {
+        // Its "elementN" id didn't fit WEBGUI_ID_CAPACITY; an empty id would
+        // clash in /get and /set with every other one
+        WEBGUI_LOG_ERROR("WebGUI: element id too long, increase WEBGUI_ID_CAPACITY");
+        return false;
+    }
+    if (!elements.add(element)) {
+        WEBGUI_LOG_ERROR("WebGUI: element limit reached, increase WEBGUI_MAX_ELEMENTS");
+        return false;
+    }
+    return true;
 }
 
 GUIElement* WebGUI::findElementByID(const String& id) {
     for (GUIElement* element : elements) {
-        if (element->getID() == id) {
+        if (element->hasID(id.c_str())) {
             return element;
         }
     }
@@ -154,71 +319,97 @@ GUIElement* WebGUI::findElementByID(const String& id) {
 
 void WebGUI::startAP(const char* ssid, const char* password) {
     apMode = true;
+    unsigned long phaseStart = millis();
 #if defined(ARDUINO_UNOWIFIR4)
     WiFi.beginAP(ssid, password);
-    Serial.println("Access Point started");
-    Serial.println("SSID: " + String(ssid));
-    Serial.println("IP: " + WiFi.localIP().toString());
+    boot.record(WEBGUI_BOOT_RADIO, phaseStart);
+    WEBGUI_LOG_INFO("Access Point started");
+    WEBGUI_LOG_INFO("SSID: ", ssid);
+    WEBGUI_LOG_INFO("IP: ", WiFi.localIP().toString());
 #elif defined(ARDUINO_SAMD_NANO_33_IOT)
     WiFi.beginAP(ssid, password);
-    Serial.println("Access Point started");
-    Serial.println("SSID: " + String(ssid));
-    Serial.println("IP: " + WiFi.localIP().toString());
+    boot.record(WEBGUI_BOOT_RADIO, phaseStart);
+    WEBGUI_LOG_INFO("Access Point started");
+    WEBGUI_LOG_INFO("SSID: ", ssid);
+    WEBGUI_LOG_INFO("IP: ", WiFi.localIP().toString());
 #elif defined(ESP32)
     WiFi.softAP(ssid, password);
-    Serial.println("Access Point started");
-    Serial.println("SSID: " + String(ssid));
-    Serial.println("IP: " + WiFi.softAPIP().toString());
+    boot.record(WEBGUI_BOOT_RADIO, phaseStart);
+    WEBGUI_LOG_INFO("Access Point started");
+    WEBGUI_LOG_INFO("SSID: ", ssid);
+    WEBGUI_LOG_INFO("IP: ", WiFi.softAPIP().toString());
 #endif
 }
 
 bool WebGUI::connectWiFi(const char* ssid, const char* password) {
     apMode = false;
+    unsigned long phaseStart = millis();
     WiFi.begin(ssid, password);
+    boot.record(WEBGUI_BOOT_RADIO, phaseStart);
     
-    // Wait up to 30 seconds for connection
-    int attempts = 0;
-    const int maxAttempts = 30;
-    
-    while (WiFi.status() != WL_CONNECTED && attempts < maxAttempts) {
-        delay(1000);
-        Serial.print(".");
-        attempts++;
-    }
-    
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\nWiFi connected");
-        Serial.println("IP: " + WiFi.localIP().toString());
+    if (waitForWiFi(true)) {
+        WEBGUI_LOG_INFO("\nWiFi connected");
+        WEBGUI_LOG_INFO("IP: ", WiFi.localIP().toString());
         return true;
     } else {
-        Serial.println("\nWiFi connection failed");
+        WEBGUI_LOG_WARN("\nWiFi connection failed");
         return false;
     }
 }
 
+// Waits up to WEBGUI_WIFI_TIMEOUT_MS for WL_CONNECTED, checking every
+// WEBGUI_WIFI_POLL_MS and printing a dot each second, then with dhcp for an
+// address. Most stacks report WL_CONNECTED only once they hold a lease, so
+// the DHCP phase is usually 0 ms; the timeline shows the ones that don't.
+bool WebGUI::waitForWiFi(bool dhcp) {
+    unsigned long phaseStart = millis();
+    unsigned long nextDot = phaseStart + 1000;
+    while (WiFi.status() != WL_CONNECTED && millis() - phaseStart < WEBGUI_WIFI_TIMEOUT_MS) {
+        delay(WEBGUI_WIFI_POLL_MS);
+        if ((long)(millis() - nextDot) >= 0) {
+            WEBGUI_LOG_PROGRESS();
+            nextDot += 1000;
+        }
+    }
+    bool connected = WiFi.status() == WL_CONNECTED;
+    boot.record(WEBGUI_BOOT_ASSOCIATE, phaseStart, connected);
+    
+    if (connected && dhcp) {
+        unsigned long leaseStart = millis();
+        while ((uint32_t)WiFi.localIP() == 0 && millis() - phaseStart < WEBGUI_WIFI_TIMEOUT_MS) {
+            delay(10);
+        }
+        boot.record(WEBGUI_BOOT_DHCP, leaseStart, (uint32_t)WiFi.localIP() != 0);
+    }
+    return connected;
+}
+
 bool WebGUI::configureStaticIP(const char* ip, const char* subnet, const char* gateway) {
     IPAddress staticIP, subnetMask, gatewayIP;
     
     if (!staticIP.fromString(ip) || !subnetMask.fromString(subnet) || !gatewayIP.fromString(gateway)) {
-        Serial.println("Error: Invalid IP configuration format");
+        WEBGUI_LOG_ERROR("Error: Invalid IP configuration format");
         return false;
     }
     
+    unsigned long phaseStart = millis();
 #if defined(ESP32)
     if (!WiFi.config(staticIP, gatewayIP, subnetMask)) {
-        Serial.println("Error: Failed to configure static IP");
+        boot.record(WEBGUI_BOOT_STATIC_IP, phaseStart, false);
+        WEBGUI_LOG_ERROR("Error: Failed to configure static IP");
         return false;
     }
 #else
     // For Arduino boards (UNO R4 WiFi, Nano 33 IoT), WiFi.config() returns void
     WiFi.config(staticIP, gatewayIP, subnetMask);
-    Serial.println("Static IP configuration applied (Arduino)");
+    WEBGUI_LOG_INFO("Static IP configuration applied (Arduino)");
 #endif
+    boot.record(WEBGUI_BOOT_STATIC_IP, phaseStart);
     
-    Serial.println("Static IP configured successfully");
-    Serial.println("IP: " + staticIP.toString());
-    Serial.println("Subnet: " + subnetMask.toString());
-    Serial.println("Gateway: " + gatewayIP.toString());
+    WEBGUI_LOG_INFO("Static IP configured successfully");
+    WEBGUI_LOG_INFO("IP: ", staticIP.toString());
+    WEBGUI_LOG_INFO("Subnet: ", subnetMask.toString());
+    WEBGUI_LOG_INFO("Gateway: ", gatewayIP.toString());
     return true;
 }
 
@@ -231,20 +422,16 @@ bool WebGUI::connectWiFiWithStaticIP(const char* ssid, const char* password, con
     }
     
     // Connect to WiFi
+    unsigned long phaseStart = millis();
     WiFi.begin(ssid, password);
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 30) {
-        delay(1000);
-        Serial.print(".");
-        attempts++;
-    }
+    boot.record(WEBGUI_BOOT_RADIO, phaseStart);
     
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\nWiFi connected with static IP");
-        Serial.println("IP: " + WiFi.localIP().toString());
+    if (waitForWiFi(false)) {
+        WEBGUI_LOG_INFO("\nWiFi connected with static IP");
+        WEBGUI_LOG_INFO("IP: ", WiFi.localIP().toString());
         return true;
     } else {
-        Serial.println("\nFailed to connect to WiFi with static IP");
+        WEBGUI_LOG_WARN("\nFailed to connect to WiFi with static IP");
         return false;
     }
 }
@@ -275,12 +462,12 @@ String WebGUI::getCurrentGateway() {
     IPAddress gateway = network;
     gateway[3] = gateway[3] + 1;
     
-    Serial.println("Gateway calculation workaround:");
-    Serial.println("  IP: " + ip.toString());
-    Serial.println("  Subnet: " + subnet.toString());
-    Serial.println("  Network: " + network.toString());
-    Serial.println("  Calculated Gateway: " + gateway.toString());
-    Serial.println("  WiFi.gatewayIP(): " + WiFi.gatewayIP().toString());
+    WEBGUI_LOG_DEBUG("Gateway calculation workaround:");
+    WEBGUI_LOG_DEBUG("  IP: ", ip.toString());
+    WEBGUI_LOG_DEBUG("  Subnet: ", subnet.toString());
+    WEBGUI_LOG_DEBUG("  Network: ", network.toString());
+    WEBGUI_LOG_DEBUG("  Calculated Gateway: ", gateway.toString());
+    WEBGUI_LOG_DEBUG("  WiFi.gatewayIP(): ", WiFi.gatewayIP().toString());
     
     return gateway.toString();
 #else
@@ -289,7 +476,7 @@ String WebGUI::getCurrentGateway() {
 }
 
 void WebGUI::restartDevice() {
-    Serial.println("🔄 Restarting device...");
+    WEBGUI_LOG_INFO("🔄 Restarting device...");
     delay(1000);  // Give serial time to print
     
 #if defined(ESP32)
@@ -300,40 +487,36 @@ void WebGUI::restartDevice() {
     NVIC_SystemReset();  // For Arduino Nano 33 IoT
 #else
     // Fallback: infinite loop to halt execution
-    Serial.println("⚠️ Platform-specific restart not available, halting...");
+    WEBGUI_LOG_WARN("⚠️ Platform-specific restart not available, halting...");
     while(1) { delay(1000); }
 #endif
 }
 
 bool WebGUI::autoConfigureNetworkRange(const char* ssid, const char* password, int deviceNumber) {
-    Serial.println("🔍 AUTO-DISCOVERY STARTED: Attempting to discover network range...");
+    WEBGUI_LOG_INFO("🔍 AUTO-DISCOVERY STARTED: Attempting to discover network range...");
     
     // Step 1: Connect via DHCP to discover network
-    Serial.println("Step 1: Connecting via DHCP to discover network...");
+    WEBGUI_LOG_INFO("Step 1: Connecting via DHCP to discover network...");
+    unsigned long phaseStart = millis();
     WiFi.begin(ssid, password);
-    int attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 30) {
-        delay(1000);
-        Serial.print(".");
-        attempts++;
-    }
+    boot.record(WEBGUI_BOOT_RADIO, phaseStart);
     
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("\n❌ AUTO-DISCOVERY FAILED: Could not connect via DHCP");
+    if (!waitForWiFi(true)) {
+        WEBGUI_LOG_WARN("\n❌ AUTO-DISCOVERY FAILED: Could not connect via DHCP");
         return false;
     }
     
-    Serial.println("\n✅ DHCP connection successful!");
+    WEBGUI_LOG_INFO("\n✅ DHCP connection successful!");
     
     // Step 2: Extract network information
     IPAddress dhcpIP = WiFi.localIP();
     IPAddress gateway = WiFi.gatewayIP();
     IPAddress subnet = WiFi.subnetMask();
     
-    Serial.println("Step 2: Discovered network configuration:");
-    Serial.println("  DHCP IP: " + dhcpIP.toString());
-    Serial.println("  Gateway (raw): " + gateway.toString());
-    Serial.println("  Subnet: " + subnet.toString());
+    WEBGUI_LOG_INFO("Step 2: Discovered network configuration:");
+    WEBGUI_LOG_INFO("  DHCP IP: ", dhcpIP.toString());
+    WEBGUI_LOG_INFO("  Gateway (raw): ", gateway.toString());
+    WEBGUI_LOG_INFO("  Subnet: ", subnet.toString());
     
 #if defined(ARDUINO_UNOWIFIR4)
     // Apply gateway workaround for UNO R4 WiFi
@@ -345,47 +528,46 @@ bool WebGUI::autoConfigureNetworkRange(const char* ssid, const char* password, i
     
     gateway = network;
     gateway[3] = gateway[3] + 1;
-    Serial.println("  Gateway (corrected): " + gateway.toString());
+    WEBGUI_LOG_INFO("  Gateway (corrected): ", gateway.toString());
 #endif
     
     // Step 3: Calculate desired static IP based on network range
     IPAddress staticIP = calculateStaticIP(gateway, subnet, deviceNumber);
     
-    Serial.println("Step 3: Calculated Static IP: " + staticIP.toString());
+    WEBGUI_LOG_INFO("Step 3: Calculated Static IP: ", staticIP.toString());
     
     // Step 4: Disconnect and reconnect with static IP
-    Serial.println("Step 4: Switching to static IP configuration...");
+    WEBGUI_LOG_INFO("Step 4: Switching to static IP configuration...");
+    phaseStart = millis();
     WiFi.disconnect();
     delay(1000);
     
 #if defined(ESP32)
     if (!WiFi.config(staticIP, gateway, subnet)) {
-        Serial.println("Failed to configure static IP");
+        boot.record(WEBGUI_BOOT_STATIC_IP, phaseStart, false);
+        WEBGUI_LOG_ERROR("Failed to configure static IP");
         return false;
     }
 #else
     // For Arduino boards (UNO R4 WiFi, Nano 33 IoT), WiFi.config() returns void
     WiFi.config(staticIP, gateway, subnet);
-    Serial.println("Static IP configuration applied (Arduino)");
+    WEBGUI_LOG_INFO("Static IP configuration applied (Arduino)");
 #endif
+    boot.record(WEBGUI_BOOT_STATIC_IP, phaseStart);
     
+    phaseStart = millis();
     WiFi.begin(ssid, password);
-    attempts = 0;
-    while (WiFi.status() != WL_CONNECTED && attempts < 30) {
-        delay(1000);
-        Serial.print(".");
-        attempts++;
-    }
-    
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("\n✅ AUTO-DISCOVERY SUCCESSFUL!");
-        Serial.println("Final configuration:");
-        Serial.println("  IP: " + WiFi.localIP().toString());
-        Serial.println("  Subnet: " + WiFi.subnetMask().toString());
-        Serial.println("  Gateway: " + getCurrentGateway());
+    boot.record(WEBGUI_BOOT_RADIO, phaseStart);
+    
+    if (waitForWiFi(false)) {
+        WEBGUI_LOG_INFO("\n✅ AUTO-DISCOVERY SUCCESSFUL!");
+        WEBGUI_LOG_INFO("Final configuration:");
+        WEBGUI_LOG_INFO("  IP: ", WiFi.localIP().toString());
+        WEBGUI_LOG_INFO("  Subnet: ", WiFi.subnetMask().toString());
+        WEBGUI_LOG_INFO("  Gateway: ", getCurrentGateway());
         return true;
     } else {
-        Serial.println("\n❌ AUTO-DISCOVERY FAILED: Could not reconnect with static IP");
+        WEBGUI_LOG_WARN("\n❌ AUTO-DISCOVERY FAILED: Could not reconnect with static IP");
         return false;
     }
 }
@@ -415,18 +597,16 @@ void WebGUI::setTitle(const char* title) {
     pageHeading = String(title);  // Set both title and heading to the same value
 }
 
-void WebGUI::setCustomCSS(const char* customCSS) {
-    this->customCSS = String(customCSS);
-    useCustomStyles = true;
+void WebGUI::setCustomCSS(WebGUIText customCSS) {
+    this->customCSS = customCSS;
 }
 
 void WebGUI::setTheme(const WebGUITheme& theme) {
-    customCSS = WebGUIStyleManager::getThemedCSS(theme);
-    useCustomStyles = true;
+    this->theme = theme;
 }
 
 void WebGUI::useDefaultStyles() {
-    useCustomStyles = false;
+    theme = WEBGUI_DEFAULT_THEME;
     customCSS = "";
 }
 
@@ -439,136 +619,533 @@ String WebGUI::getIP() {
 }
 
 void WebGUI::setupRoutes() {
-#if defined(ESP32)
+#if WEBGUI_USE_WEBSERVER
     server->on("/", [this]() { handleRoot(); });
     server->on("/set", [this]() { handleSet(); });
     server->on("/get", [this]() { handleGet(); });
+#if WEBGUI_METRICS
+    server->on("/metrics", [this]() { handleMetrics(); });
+#endif
+#if WEBGUI_TRACE_SIZE > 0
+    server->on("/debug/trace", [this]() { handleTrace(); });
+#endif
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+    server->on("/debug/log", [this]() { handleLog(); });
+#endif
+#if WEBGUI_BOOT_TIMELINE_SIZE > 0
+    server->on("/debug/boot", [this]() { handleBoot(); });
+#endif
+#if WEBGUI_CAPTURE_SIZE > 0
+    server->on("/debug/capture", [this]() { handleCapture(); });
+#endif
 #endif
     // For Arduino boards, routes are handled in processClient()
 }
 
-#if !defined(ESP32)
+#if WEBGUI_TRACE_SIZE > 0
+static void setTraceClientIP(WebGUITraceEntry& entry, const IPAddress& ip) {
+    for (int i = 0; i < 4; i++) {
+        entry.clientIP[i] = ip[i];
+    }
+}
+#endif
+
+#if !WEBGUI_USE_WEBSERVER
 void WebGUI::processClient() {
-    WiFiClient client = server->available();
-    if (client) {
-        String currentLine = "";
-        httpRequest = "";
-        
-        while (client.connected()) {
-            if (client.available()) {
+    // Calls into the WiFi library may allocate (client handles, receive
+    // buffers) and are exempt; the zero-heap guarantee covers this library
+    WiFiClient client;
+    {
+        WebGUIHeapExempt networkCall;
+        client = server->available();
+    }
+    if (!client) {
+        return;
+    }
+    unsigned long startTime = micros();
+    metrics.connectionOpened();
+    updateRoute = WEBGUI_ROUTE_OTHER;  // Until the request line is known
+    
+    // Filled in as the request goes along, recorded once it is closed
+    WebGUITraceEntry traceEntry = {};
+    traceEntry.startMillis = millis();
+    traceEntry.route = WEBGUI_ROUTE_OTHER;
+#if WEBGUI_TRACE_SIZE > 0
+    {
+        WebGUIHeapExempt networkCall;
+        setTraceClientIP(traceEntry, client.remoteIP());
+    }
+#endif
+    
+    if (loadShedLevel == SHED_CONNECTIONS) {
+        // Free the socket straight away rather than let requests queue up
+        refusedConnections++;
+        {
+            WebGUIHeapExempt networkCall;
+            client.stop();
+        }
+        metrics.connectionClosed();
+        traceEntry.sendMicros = micros() - startTime;
+        trace.record(traceEntry);
+        return;
+    }
+    
+    // Only the request line is kept; headers are counted but not stored
+    char* requestLine = requestArena.allocateChars(WEBGUI_MAX_REQUEST_LINE);
+    size_t requestLength = 0;
+    size_t lineLength = 0;
+    bool firstLine = true;
+    bool requestComplete = false;
+    bool requestTooLong = false;
+    size_t bytesIn = 0;
+    capture.begin();
+    
+    {
+        WebGUIHeapExempt networkCalls;
+        unsigned long lastReceived = millis();
+        while (requestLine && client.connected()) {
+            if (!client.available()) {
+                if (millis() - lastReceived > WEBGUI_REQUEST_TIMEOUT_MS) {
+                    break;
+                }
+            } else {
                 char c = client.read();
-                httpRequest += c;
+                capture.add((uint8_t)c);
+                bytesIn++;
+                lastReceived = millis();
                 
                 if (c == '\n') {
-                    if (currentLine.length() == 0) {
-                        // End of HTTP request, process it
-                        if (httpRequest.indexOf("GET /set?") >= 0) {
-                            handleSetRequest(httpRequest);
-                            client.println("HTTP/1.1 200 OK");
-                            client.println("Content-Type: text/plain");
-                            client.println("Connection: close");
-                            client.println();
-                            client.println("OK");
-                        } else if (httpRequest.indexOf("GET /get") >= 0) {
-                            String response = generateGetResponse();
-                            client.println("HTTP/1.1 200 OK");
-                            client.println("Content-Type: application/json");
-                            client.println("Connection: close");
-                            client.println();
-                            client.println(response);
-                        } else {
-                            // MEMORY OPTIMIZED: Stream HTML directly instead of building large strings
-                            client.println("HTTP/1.1 200 OK");
-                            client.println("Content-Type: text/html");
-                            client.println("Connection: close");
-                            client.println();
-                            streamHTML(client);
-                        }
+                    if (lineLength == 0) {
+                        requestComplete = true;
                         break;
-                    } else {
-                        currentLine = "";
                     }
+                    firstLine = false;
+                    lineLength = 0;
                 } else if (c != '\r') {
-                    currentLine += c;
+                    if (firstLine) {
+                        if (requestLength < WEBGUI_MAX_REQUEST_LINE - 1) {
+                            requestLine[requestLength++] = c;
+                        } else {
+                            requestTooLong = true;
+                        }
+                    }
+                    lineLength++;
                 }
             }
         }
+    }
+    unsigned long parsedTime = micros();
+    traceEntry.parseMicros = parsedTime - startTime;
+    traceEntry.bytesIn = bytesIn < 0xFFFF ? bytesIn : 0xFFFF;
+    
+    if (requestComplete) {
+        requestLine[requestLength] = '\0';
+        WebGUIResponseWriter out(client, requestArena);
+        WebGUIRoute route = WEBGUI_ROUTE_PAGE;
+        uint16_t status = 200;
+        
+        if (requestTooLong) {
+            route = WEBGUI_ROUTE_OTHER;
+            status = 414;
+            out.print("HTTP/1.1 414 URI Too Long\r\nConnection: close\r\n\r\n");
+        } else if (strncmp(requestLine, "GET /set?", 9) == 0) {
+            WebGUIAllocScope allocScope(WEBGUI_ALLOC_SET);
+            route = WEBGUI_ROUTE_SET;
+            handleSetRequest(requestLine + 9);
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Connection: close\r\n"
+                      "\r\n"
+                      "OK\r\n");
+        } else if (strncmp(requestLine, "GET /get", 8) == 0) {
+            WebGUIAllocScope allocScope(WEBGUI_ALLOC_GET);
+            route = WEBGUI_ROUTE_GET;
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: application/json\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+            streamGetResponse(out);
+            out.print("\r\n");
+#if WEBGUI_METRICS
+        } else if (strncmp(requestLine, "GET /metrics", 12) == 0) {
+            route = WEBGUI_ROUTE_METRICS;
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/plain; version=0.0.4\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+            streamMetrics(out);
+#endif
+#if WEBGUI_TRACE_SIZE > 0
+        } else if (strncmp(requestLine, "GET /debug/trace", 16) == 0) {
+            route = WEBGUI_ROUTE_TRACE;
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+            trace.dump(out);
+#endif
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+        } else if (strncmp(requestLine, "GET /debug/log", 14) == 0) {
+            route = WEBGUI_ROUTE_LOG;
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+            webguiLog.dump(out);
+#endif
+#if WEBGUI_BOOT_TIMELINE_SIZE > 0
+        } else if (strncmp(requestLine, "GET /debug/boot", 15) == 0) {
+            route = WEBGUI_ROUTE_BOOT;
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+            boot.dump(out);
+#endif
+#if WEBGUI_CAPTURE_SIZE > 0
+        } else if (strncmp(requestLine, "GET /debug/capture", 18) == 0) {
+            // Left out of the capture itself, then ?start, ?stop or ?clear
+            route = WEBGUI_ROUTE_CAPTURE;
+            capture.cancel();
+            if (requestLine[18] == '?') {
+                capture.control(requestLine + 19);
+            }
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/plain\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+            capture.dump(out);
+#endif
+        } else if (loadShedLevel != SHED_NONE) {
+            shedPageRequests++;
+            status = 503;
+            out.print("HTTP/1.1 503 Service Unavailable\r\n"
+                      "Retry-After: 5\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+        } else {
+            // MEMORY OPTIMIZED: Stream HTML directly instead of building large strings
+            WebGUIAllocScope allocScope(WEBGUI_ALLOC_PAGE);
+            out.print("HTTP/1.1 200 OK\r\n"
+                      "Content-Type: text/html\r\n"
+                      "Connection: close\r\n"
+                      "\r\n");
+            resetSaveStatusElements();
+            streamHTML(out);
+        }
+        out.flush();
+        unsigned long handledTime = micros();
+        metrics.recordRequest(route, bytesIn, out.bytesWritten(), handledTime - startTime);
+        updateRoute = route;
+        if (route == WEBGUI_ROUTE_PAGE && status == 200) {
+            pageServed();
+        }
+        
+        traceEntry.route = route;
+        traceEntry.status = status;
+        traceEntry.bytesOut = out.bytesWritten();
+        traceEntry.sendMicros = out.getSinkMicros();
+        traceEntry.handleMicros = handledTime - parsedTime - traceEntry.sendMicros;
+    }
+    
+    capture.commit();  // Timed-out and unanswered requests included
+    sampleMemoryStats();
+    unsigned long stopTime = micros();
+    {
+        WebGUIHeapExempt networkCall;
         client.stop();
     }
+    metrics.connectionClosed();
+    traceEntry.sendMicros += micros() - stopTime;
+    trace.record(traceEntry);
+    requestArena.reset();
+}
+
+// Decode %XX and '+' in place; returns the decoded length
+static size_t urlDecodeInPlace(char* text) {
+    char* in = text;
+    char* out = text;
+    while (*in) {
+        if (*in == '+') {
+            *out++ = ' ';
+            in++;
+        } else if (*in == '%' && isxdigit((unsigned char)in[1]) && isxdigit((unsigned char)in[2])) {
+            char hex[3] = { in[1], in[2], '\0' };
+            *out++ = (char)strtol(hex, nullptr, 16);
+            in += 3;
+        } else {
+            *out++ = *in++;
+        }
+    }
+    *out = '\0';
+    return out - text;
 }
 
-void WebGUI::handleSetRequest(String request) {
-    // Parse parameters from GET request
-    int paramStart = request.indexOf("?") + 1;
-    int paramEnd = request.indexOf(" ", paramStart);
-    String params = request.substring(paramStart, paramEnd);
-    
-    // Split multiple parameters
-    int start = 0;
-    int end = params.indexOf("&");
+void WebGUI::handleSetRequest(char* query) {
+    // Parameters end at the space before "HTTP/1.1"
+    char* queryEnd = strchr(query, ' ');
+    if (queryEnd) {
+        *queryEnd = '\0';
+    }
     
-    while (start < params.length()) {
-        String param;
-        if (end == -1) {
-            param = params.substring(start);
-            start = params.length();
-        } else {
-            param = params.substring(start, end);
-            start = end + 1;
-            end = params.indexOf("&", start);
+    // Split multiple parameters in place: name=value&name=value
+    char* param = query;
+    while (param && *param) {
+        char* next = strchr(param, '&');
+        if (next) {
+            *next++ = '\0';
         }
         
         // Parse parameter name and value
-        int eqPos = param.indexOf("=");
-        if (eqPos > 0) {
-            String paramName = param.substring(0, eqPos);
-            String paramValue = param.substring(eqPos + 1);
+        char* eq = strchr(param, '=');
+        if (eq && eq > param) {
+            *eq = '\0';
+            char* paramValue = eq + 1;
+            urlDecodeInPlace(param);
+            urlDecodeInPlace(paramValue);
             
             // Find matching element
             for (GUIElement* element : elements) {
-                if (element->getID() == paramName) {
-                    element->handleUpdate(paramValue);
+                if (element->hasID(param)) {
+                    element->applyUpdate(paramValue);
                     break;
                 }
             }
         }
+        param = next;
     }
 }
+#endif
 
-String WebGUI::generateGetResponse() {
-    String response = "{";
-    for (size_t i = 0; i < elements.size(); i++) {
-        if (i > 0) response += ",";
-        response += "\"" + elements[i]->getID() + "\":\"" + elements[i]->getValue() + "\"";
+#if WEBGUI_USE_WEBSERVER
+// Hands buffered output to WebServer as chunks of a chunked response
+class WebServerContentSink : public Print {
+  public:
+    explicit WebServerContentSink(WebServer& server) : server(server) {}
+    
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t size) override {
+        server.sendContent(reinterpret_cast<const char*>(data), size);
+        return size;
+    }
+    
+  private:
+    WebServer& server;
+};
+
+#if WEBGUI_CAPTURE_SIZE > 0
+// Percent-encodes all but unreserved URI characters
+static void captureEncoded(WebGUICapture& capture, const String& text) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    for (size_t i = 0; i < text.length(); i++) {
+        uint8_t c = (uint8_t)text[i];
+        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            capture.add(c);
+        } else {
+            capture.add('%');
+            capture.add(HEX_DIGITS[c >> 4]);
+            capture.add(HEX_DIGITS[c & 0x0F]);
+        }
+    }
+}
+
+// WebServer has consumed the request by the time a handler runs and keeps
+// only the URI and decoded arguments, so the capture gets a minimal GET
+// rebuilt from them; the headers the browser sent are lost
+static void captureWebServerRequest(WebServer& server, WebGUICapture& capture) {
+    capture.begin();
+    capture.add("GET ");
+    capture.add(server.uri().c_str());
+    for (int i = 0; i < server.args(); i++) {
+        capture.add(i == 0 ? '?' : '&');
+        captureEncoded(capture, server.argName(i));
+        capture.add('=');
+        captureEncoded(capture, server.arg(i));
     }
-    response += "}";
-    return response;
+    capture.add(" HTTP/1.1\r\n\r\n");
+    capture.commit();
 }
 #endif
 
-void WebGUI::handleRoot() {
-#if defined(ESP32)
-    // Reset save status elements when page is refreshed
-    // Look for elements with "Save Status" in the label
-    for (GUIElement* element : elements) {
-        Serial.println("Checking element: " + element->getLabel() + " = " + element->getValue());
-        if (element->getLabel().indexOf("Save Status") >= 0) {
-            String currentValue = element->getValue();
-            Serial.println("Found Save Status element with value: " + currentValue);
-            if (currentValue.indexOf("saved") >= 0 || currentValue.indexOf("Saving") >= 0) {
-                Serial.println("Resetting save status to 'Ready to save settings'");
-                element->handleUpdate("Ready to save settings");
-            }
+// Times a WebServer handler and records it in the metrics and the trace
+// when the handler returns, and in the capture as it starts. WebServer has
+// already parsed the request, so bytes in are estimated from the URI and
+// arguments, bytes out and send time cover the body only.
+class WebServerRequestRecord {
+  public:
+    WebServerRequestRecord(WebServer& server, WebGUIMetrics& metrics, WebGUITrace& trace,
+                           WebGUICapture& capture, WebGUIRoute route)
+        : bytesOut(0), sendMicros(0), status(200), server(server), metrics(metrics), trace(trace),
+          route(route), startMillis(millis()), startTime(micros()) {
+        metrics.connectionOpened();
+#if WEBGUI_CAPTURE_SIZE > 0
+        if (capture.isRunning() && route != WEBGUI_ROUTE_CAPTURE) {
+            captureWebServerRequest(server, capture);
         }
+#endif
     }
     
-    String html = generateHTML();
-    server->send(200, "text/html", html);
+    ~WebServerRequestRecord() {
+        uint32_t elapsed = micros() - startTime;
+#if WEBGUI_METRICS || WEBGUI_TRACE_SIZE > 0
+        uint32_t bytesIn = server.uri().length();
+        for (int i = 0; i < server.args(); i++) {
+            bytesIn += server.argName(i).length() + server.arg(i).length() + 2;  // '&' or '?', '='
+        }
+        metrics.recordRequest(route, bytesIn, bytesOut, elapsed);
+#endif
+        metrics.connectionClosed();
+        
+#if WEBGUI_TRACE_SIZE > 0
+        WebGUITraceEntry entry = {};
+        entry.startMillis = startMillis;
+        entry.handleMicros = elapsed - sendMicros;
+        entry.sendMicros = sendMicros;
+        entry.bytesIn = bytesIn < 0xFFFF ? bytesIn : 0xFFFF;
+        entry.bytesOut = bytesOut;
+        entry.status = status;
+        entry.route = route;
+        setTraceClientIP(entry, server.client().remoteIP());
+        trace.record(entry);
+#endif
+    }
+    
+    size_t bytesOut;
+    unsigned long sendMicros;
+    uint16_t status;
+    
+  private:
+    WebServer& server;
+    WebGUIMetrics& metrics;
+    WebGUITrace& trace;
+    WebGUIRoute route;
+    unsigned long startMillis;
+    unsigned long startTime;
+};
+#endif
+
+// The first page served ends startup in the boot timeline
+void WebGUI::pageServed() {
+    if (boot.isReady()) {
+        return;
+    }
+    boot.markReady();
+    WEBGUI_LOG_INFO("WebGUI ready: first page served ", boot.getReadyMillis(), " ms after boot");
+}
+
+// Reset save status elements when page is refreshed
+// Look for elements with "Save Status" in the label
+void WebGUI::resetSaveStatusElements() {
+    for (GUIElement* element : elements) {
+        bool saveStatus = strstr(element->getLabelCStr(), "Save Status") != nullptr;
+        if (!saveStatus && WEBGUI_LOG_LEVEL < WEBGUI_LOG_LEVEL_DEBUG) {
+            continue;  // Other values are only read for the debug log
+        }
+        
+        // Values are read into a stack buffer; long ones are cut short,
+        // which only affects the log line
+        char value[48];
+        WebGUIBufferPrint valueText(value, sizeof(value));
+        element->streamValue(valueText);
+        
+        WEBGUI_LOG_DEBUG("Checking element: ", element->getLabelCStr(), " = ", value);
+        if (saveStatus && (strstr(value, "saved") || strstr(value, "Saving"))) {
+            WEBGUI_LOG_DEBUG("Resetting save status to 'Ready to save settings'");
+            element->applyUpdate("Ready to save settings");
+        }
+    }
+}
+
+// Attributes what the tap counted since the last call to part (and element)
+inline void WebGUI::countBytes(WebGUIBytesPart part, WebGUIByteTap& tap, GUIElement* element) {
+#if WEBGUI_BYTE_STATS
+    uint32_t bytes = tap.take();
+    if (!countingBytes) {
+        return;
+    }
+    byteStats.add(part, bytes);
+    if (element) {
+        element->wireBytes[part] += bytes;
+    }
+#endif
+}
+
+// {"element0":"value",...} with values escaped for JSON
+void WebGUI::streamGetResponse(Print& target) {
+    WebGUIByteTap tap(target);
+    Print& out = tap.out();
+    WebGUIJSONEscaper jsonValue(out);
+    out.print('{');
+    countBytes(WEBGUI_BYTES_FRAMING, tap);
+    for (size_t i = 0; i < elements.size(); i++) {
+        if (i > 0) out.print(',');
+        out.print('"');
+        out.print(elements[i]->getIDCStr());
+        out.print("\":\"");
+        elements[i]->streamValue(jsonValue);
+        out.print('"');
+        countBytes(WEBGUI_BYTES_VALUE, tap, elements[i]);
+    }
+    out.print('}');
+    countBytes(WEBGUI_BYTES_FRAMING, tap);
+}
+
+// The same bytes the page and /get routes send, with nothing recorded
+void WebGUI::renderPage(Print& out) {
+    countingBytes = false;
+#if WEBGUI_USE_WEBSERVER
+    streamTemplateHTML(out);
+#else
+    streamHTML(out);
+#endif
+    countingBytes = true;
+}
+
+void WebGUI::renderValues(Print& out) {
+    countingBytes = false;
+    streamGetResponse(out);
+    countingBytes = true;
+}
+
+void WebGUI::handleRoot() {
+#if WEBGUI_USE_WEBSERVER
+    WebGUIAllocScope allocScope(WEBGUI_ALLOC_PAGE);
+    WebServerRequestRecord request(*server, metrics, trace, capture, WEBGUI_ROUTE_PAGE);
+    updateRoute = WEBGUI_ROUTE_PAGE;
+    if (loadShedLevel != SHED_NONE) {
+        static const char SHED_MESSAGE[] PROGMEM = "Low memory, retry shortly";
+        shedPageRequests++;
+        server->sendHeader("Retry-After", "5");
+        server->send_P(503, "text/plain", SHED_MESSAGE);
+        request.bytesOut = sizeof(SHED_MESSAGE) - 1;
+        request.status = 503;
+        return;
+    }
+    
+    resetSaveStatusElements();
+    
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, "text/html", "");
+    WebServerContentSink sink(*server);
+    {
+        WebGUIResponseWriter out(sink, requestArena);
+        streamTemplateHTML(out);
+        out.flush();
+        request.bytesOut = out.bytesWritten();
+        request.sendMicros = out.getSinkMicros();
+    }
+    server->sendContent("");  // Terminating chunk
+    requestArena.reset();
+    pageServed();
 #endif
 }
 
 void WebGUI::handleSet() {
-#if defined(ESP32)
+#if WEBGUI_USE_WEBSERVER
+    WebGUIAllocScope allocScope(WEBGUI_ALLOC_SET);
+    WebServerRequestRecord request(*server, metrics, trace, capture, WEBGUI_ROUTE_SET);
+    updateRoute = WEBGUI_ROUTE_SET;
+    
     // Process all arguments
     for (int i = 0; i < server->args(); i++) {
         String paramName = server->argName(i);
@@ -576,167 +1153,290 @@ void WebGUI::handleSet() {
         
         // Find the element with matching ID
         for (GUIElement* element : elements) {
-            if (element->getID() == paramName) {
-                element->handleUpdate(paramValue);
+            if (element->hasID(paramName.c_str())) {
+                element->applyUpdate(paramValue.c_str());
                 break;
             }
         }
     }
     
-    server->send(200, "text/plain", "OK");
+    server->send_P(200, "text/plain", "OK");
+    request.bytesOut = 2;
 #endif
 }
 
 void WebGUI::handleGet() {
-#if defined(ESP32)
-    String response = "{";
-    for (size_t i = 0; i < elements.size(); i++) {
-        if (i > 0) response += ",";
-        response += "\"" + elements[i]->getID() + "\":\"" + elements[i]->getValue() + "\"";
-    }
-    response += "}";
-    
-    server->send(200, "application/json", response);
+#if WEBGUI_USE_WEBSERVER
+    WebGUIAllocScope allocScope(WEBGUI_ALLOC_GET);
+    WebServerRequestRecord request(*server, metrics, trace, capture, WEBGUI_ROUTE_GET);
+    updateRoute = WEBGUI_ROUTE_GET;
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, "application/json", "");
+    WebServerContentSink sink(*server);
+    {
+        WebGUIResponseWriter out(sink, requestArena);
+        streamGetResponse(out);
+        out.flush();
+        request.bytesOut = out.bytesWritten();
+        request.sendMicros = out.getSinkMicros();
+    }
+    server->sendContent("");  // Terminating chunk
+    requestArena.reset();
 #endif
 }
 
-String WebGUI::generateHTML() {
-    String html = String(HTML_TEMPLATE);
-    
-    // Set title and heading
-    html.replace("%TITLE%", pageTitle);
-    html.replace("%HEADING%", pageHeading);
-    
-    // Generate CSS
-    String css = generateCSS();
-    html.replace("%CSS%", css);
-    
-    // Generate HTML elements
-    String elementsHTML = "";
+void WebGUI::handleMetrics() {
+#if WEBGUI_USE_WEBSERVER && WEBGUI_METRICS
+    serveDebugText(WEBGUI_ROUTE_METRICS, "text/plain; version=0.0.4",
+                   [](WebGUI& gui, Print& out) { gui.streamMetrics(out); });
+#endif
+}
+
+void WebGUI::handleTrace() {
+#if WEBGUI_USE_WEBSERVER && WEBGUI_TRACE_SIZE > 0
+    serveDebugText(WEBGUI_ROUTE_TRACE, "text/plain", [](WebGUI& gui, Print& out) { gui.trace.dump(out); });
+#endif
+}
+
+void WebGUI::handleLog() {
+#if WEBGUI_USE_WEBSERVER && WEBGUI_LOG_BUFFER_SIZE > 0
+    serveDebugText(WEBGUI_ROUTE_LOG, "text/plain", [](WebGUI&, Print& out) { webguiLog.dump(out); });
+#endif
+}
+
+void WebGUI::handleBoot() {
+#if WEBGUI_USE_WEBSERVER && WEBGUI_BOOT_TIMELINE_SIZE > 0
+    serveDebugText(WEBGUI_ROUTE_BOOT, "text/plain", [](WebGUI& gui, Print& out) { gui.boot.dump(out); });
+#endif
+}
+
+void WebGUI::handleCapture() {
+#if WEBGUI_USE_WEBSERVER && WEBGUI_CAPTURE_SIZE > 0
+    // ?start, ?stop or ?clear applies before the capture is sent
+    serveDebugText(WEBGUI_ROUTE_CAPTURE, "text/plain", [](WebGUI& gui, Print& out) {
+        if (gui.server->args() > 0) {
+            gui.capture.control(gui.server->argName(0).c_str());
+        }
+        gui.capture.dump(out);
+    });
+#endif
+}
+
+#if WEBGUI_USE_WEBSERVER
+// A plain-text report from writer, sent as one chunked 200 response and
+// recorded in the metrics, trace and capture like any other request
+void WebGUI::serveDebugText(WebGUIRoute route, const char* contentType, DebugTextWriter writer) {
+    WebServerRequestRecord request(*server, metrics, trace, capture, route);
+    updateRoute = route;
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, contentType, "");
+    WebServerContentSink sink(*server);
+    {
+        WebGUIResponseWriter out(sink, requestArena);
+        writer(*this, out);
+        out.flush();
+        request.bytesOut = out.bytesWritten();
+        request.sendMicros = out.getSinkMicros();
+    }
+    server->sendContent("");  // Terminating chunk
+    requestArena.reset();
+}
+#endif
+
+// Library-wide counters first, then the gauges only WebGUI knows about
+void WebGUI::streamMetrics(Print& out) {
+#if WEBGUI_METRICS
+    metrics.stream(out, updateTimes);
+    out.println("# TYPE webgui_request_arena_peak_bytes gauge");
+    out.print("webgui_request_arena_peak_bytes ");
+    out.println((unsigned long)requestArena.getPeak());
+    out.println("# TYPE webgui_request_arena_failures_total counter");
+    out.print("webgui_request_arena_failures_total ");
+    out.println(requestArena.getFailures());
+    out.println("# TYPE webgui_load_shed_level gauge");
+    out.print("webgui_load_shed_level ");
+    out.println((int)loadShedLevel);
+    out.println("# TYPE webgui_shed_page_requests_total counter");
+    out.print("webgui_shed_page_requests_total ");
+    out.println(shedPageRequests);
+    out.println("# TYPE webgui_refused_connections_total counter");
+    out.print("webgui_refused_connections_total ");
+    out.println(refusedConnections);
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+    out.println("# TYPE webgui_log_dropped_bytes_total counter");
+    out.print("webgui_log_dropped_bytes_total ");
+    out.println((unsigned long)webguiLog.getDropped());
+#endif
+#if WEBGUI_BYTE_STATS
+    out.println("# TYPE webgui_response_part_bytes_total counter");
+    for (int part = 0; part < WEBGUI_BYTES_PARTS; part++) {
+        out.print("webgui_response_part_bytes_total{part=\"");
+        out.print(webguiBytesPartName(part));
+        out.print("\"} ");
+        out.println((unsigned long)byteStats.get((WebGUIBytesPart)part));
+    }
+    out.println("# TYPE webgui_element_bytes_total counter");
     for (GUIElement* element : elements) {
-        elementsHTML += element->generateHTML();
+        for (int part = 0; part < WEBGUI_ELEMENT_BYTES_PARTS; part++) {
+            out.print("webgui_element_bytes_total{id=\"");
+            out.print(element->getIDCStr());
+            out.print("\",type=\"");
+            out.print(element->getTypeName());
+            out.print("\",part=\"");
+            out.print(webguiBytesPartName(part));
+            out.print("\"} ");
+            out.println((unsigned long)element->getWireBytes((WebGUIBytesPart)part));
+        }
     }
-    html.replace("%ELEMENTS%", elementsHTML);
-    
-    // Generate JavaScript
-    String js = generateJS();
-    html.replace("%JAVASCRIPT%", js);
-    
-    return html;
+#endif
+#if WEBGUI_ZERO_HEAP_ASSERT
+    out.println("# TYPE webgui_heap_violations_total counter");
+    out.print("webgui_heap_violations_total ");
+    out.println(getHeapViolations());
+#endif
+#endif
 }
 
-String WebGUI::generateCSS() {
-    if (useCustomStyles) {
-        return customCSS;
-    } else {
-        return WebGUIStyleManager::getDefaultCSS();
+void WebGUI::resetByteStats() {
+#if WEBGUI_BYTE_STATS
+    byteStats.reset();
+    for (GUIElement* element : elements) {
+        memset(element->wireBytes, 0, sizeof(element->wireBytes));
     }
+#endif
 }
 
-String WebGUI::generateJS() {
-    String js = R"rawliteral(
-        // Button state tracking
-        var buttonStates = {};
-        
-        function updateValue(id, val) {
-            fetch('/set?' + id + '=' + val).catch(e => console.log('Error:', e));
-        }
-        
-        function buttonClick(id) {
-            fetch('/set?' + id + '=1');
+// Totals per part, per element type and per element, in page order
+void WebGUI::dumpByteStats(Print& out) {
+#if WEBGUI_BYTE_STATS
+    out.println("# part         bytes");
+    for (int part = 0; part < WEBGUI_BYTES_PARTS; part++) {
+        webguiPrintLeft(out, webguiBytesPartName(part), 8);
+        webguiPrintRight(out, byteStats.get((WebGUIBytesPart)part), 12);
+        out.println();
+    }
+    
+    // Each type is summed where it first appears
+    out.println("# type              html        js     value");
+    for (size_t i = 0; i < elements.size(); i++) {
+        const char* type = elements[i]->getTypeName();
+        bool seen = false;
+        for (size_t j = 0; j < i && !seen; j++) {
+            seen = strcmp(elements[j]->getTypeName(), type) == 0;
         }
-        
-        function toggleChange(id, checked) {
-            fetch('/set?' + id + '=' + (checked ? 'true' : 'false'));
+        if (seen) {
+            continue;
         }
-        
-        function textboxChange(id, value) {
-            fetch('/set?' + id + '=' + encodeURIComponent(value));
+        uint32_t bytes[WEBGUI_ELEMENT_BYTES_PARTS] = {};
+        for (size_t j = i; j < elements.size(); j++) {
+            if (strcmp(elements[j]->getTypeName(), type) == 0) {
+                for (int part = 0; part < WEBGUI_ELEMENT_BYTES_PARTS; part++) {
+                    bytes[part] += elements[j]->wireBytes[part];
+                }
+            }
         }
-        
-        // Initialize button states on page load
-        function initializeButtonStates() {
-            // Set all buttons to inactive state initially
-            var buttons = document.querySelectorAll('.webgui-button');
-            buttons.forEach(function(button) {
-                buttonStates[button.id] = false;
-                button.classList.add('webgui-button-inactive');
-            });
+        webguiPrintLeft(out, type, 14);
+        for (int part = 0; part < WEBGUI_ELEMENT_BYTES_PARTS; part++) {
+            webguiPrintRight(out, bytes[part], 10);
         }
-        
-        // Call initialization when page loads
-        document.addEventListener('DOMContentLoaded', initializeButtonStates);
-        
-        // Original immediate slider function (for backward compatibility)
-        function sliderChange(id, value) {
-            document.getElementById(id + '_value').textContent = value;
-            fetch('/set?' + id + '=' + value);
+        out.println();
+    }
+    
+    out.println("# id        type                html        js     value  label");
+    for (GUIElement* element : elements) {
+        webguiPrintLeft(out, element->getIDCStr(), 12);
+        webguiPrintLeft(out, element->getTypeName(), 14);
+        for (int part = 0; part < WEBGUI_ELEMENT_BYTES_PARTS; part++) {
+            webguiPrintRight(out, element->wireBytes[part], 10);
         }
-        
-        // New debounced slider function
-        function debouncedSliderChange(id, value, debounceMs) {
-            // Update display immediately for responsiveness
-            document.getElementById(id + '_value').textContent = value;
-            
-            // Clear existing timeout for this slider
-            if (window['timeout_' + id]) {
-                clearTimeout(window['timeout_' + id]);
+        out.print("  ");
+        out.println(element->getLabelCStr());
+    }
+#endif
+}
+
+// Streams a PROGMEM template, calling resolve(out, name, length) for each
+// %NAME% placeholder. Unresolved placeholders are copied through unchanged.
+template <typename Resolver>
+static void streamTemplate(Print& out, PGM_P tmpl, Resolver resolve) {
+    const char* literal = tmpl;
+    const char* p = tmpl;
+    while (*p) {
+        if (*p == '%') {
+            const char* nameStart = p + 1;
+            const char* nameEnd = nameStart;
+            while ((*nameEnd >= 'A' && *nameEnd <= 'Z') || *nameEnd == '_') {
+                nameEnd++;
             }
-            
-            // Set new timeout for network request
-            window['timeout_' + id] = setTimeout(() => {
-                fetch('/set?' + id + '=' + value);
-            }, debounceMs);
-        }
-        
-        // Auto-update function for SensorStatus displays
-        function updateSensorDisplays() {
-            fetch('/get').then(response => response.json()).then(data => {
-                for (let elementId in data) {
-                    let displayElement = document.getElementById(elementId + '_display');
-                    if (displayElement) {
-                        displayElement.textContent = data[elementId];
-                    }
-                    let toggleElement = document.getElementById(elementId);
-                    if (toggleElement && toggleElement.type === 'checkbox') {
-                        let shouldBeChecked = (data[elementId] === 'true' || data[elementId] === '1');
-                        if (toggleElement.checked !== shouldBeChecked) {
-                            toggleElement.checked = shouldBeChecked;
-                        }
-                    }
+            if (*nameEnd == '%' && nameEnd > nameStart) {
+                out.write(literal, p - literal);
+                if (!resolve(out, nameStart, (size_t)(nameEnd - nameStart))) {
+                    out.write(p, nameEnd + 1 - p);
                 }
-            }).catch(error => {
-                console.error('Update failed:', error);
-            });
+                p = literal = nameEnd + 1;
+                continue;
+            }
         }
-        
-        // Start auto-updating sensor displays every 100ms
-        setInterval(updateSensorDisplays, 100);
-        updateSensorDisplays();
-    )rawliteral";
+        p++;
+    }
+    out.write(literal, p - literal);
+}
+
+static bool placeholderIs(const char* name, size_t length, const char* expected) {
+    return strlen(expected) == length && strncmp(name, expected, length) == 0;
+}
+
+void WebGUI::streamTemplateHTML(Print& out) {
+    WebGUIByteTap tap(out);
+    streamTemplate(tap.out(), HTML_TEMPLATE, [this, &tap](Print& o, const char* name, size_t length) {
+        countBytes(WEBGUI_BYTES_FRAMING, tap);  // Template text up to here
+        if (placeholderIs(name, length, "TITLE")) {
+            o.print(pageTitle);
+        } else if (placeholderIs(name, length, "HEADING")) {
+            o.print(pageHeading);
+        } else if (placeholderIs(name, length, "CSS")) {
+            streamCSS(o);
+            countBytes(WEBGUI_BYTES_CSS, tap);
+        } else if (placeholderIs(name, length, "ELEMENTS")) {
+            streamElementsHTML(tap);
+        } else if (placeholderIs(name, length, "JAVASCRIPT")) {
+            streamJS(tap);
+        } else {
+            return false;
+        }
+        return true;
+    });
+    countBytes(WEBGUI_BYTES_FRAMING, tap);
+}
+
+void WebGUI::streamCSS(Print& out) {
+    // MEMORY OPTIMIZED: Theme variables, then flash-resident CSS, no copies
+    WebGUIStyleManager::streamCSS(out, theme);
+    out.print(customCSS.c_str());
+}
+
+void WebGUI::streamJS(WebGUIByteTap& tap) {
+    Print& out = tap.out();
+    out.print(JS_RUNTIME);
+    countBytes(WEBGUI_BYTES_SCRIPT, tap);
     
     for (GUIElement* element : elements) {
-        js += element->generateJS();
+        element->streamJS(out);
+        countBytes(WEBGUI_BYTES_JS, tap, element);
     }
-    
-    return js;
 }
 
-// MEMORY OPTIMIZED: Stream HTML directly instead of building large strings in memory
-void WebGUI::streamHTML(WiFiClient& client) {
-    // Reset save status elements when page is refreshed
-    // Look for elements with "Save Status" in the label
+void WebGUI::streamElementsHTML(WebGUIByteTap& tap) {
     for (GUIElement* element : elements) {
-        Serial.println("Checking element: " + element->getLabel() + " = " + element->getValue());
-        if (element->getLabel().indexOf("Save Status") >= 0) {
-            String currentValue = element->getValue();
-            Serial.println("Found Save Status element with value: " + currentValue);
-            if (currentValue.indexOf("saved") >= 0 || currentValue.indexOf("Saving") >= 0) {
-                Serial.println("Resetting save status to 'Ready to save settings'");
-                element->handleUpdate("Ready to save settings");
-            }
-        }
+        element->streamHTML(tap.out());
+        countBytes(WEBGUI_BYTES_HTML, tap, element);
     }
+}
+
+// MEMORY OPTIMIZED: Stream HTML directly instead of building large strings in memory
+void WebGUI::streamHTML(Print& target) {
+    WebGUIByteTap tap(target);
+    Print& client = tap.out();
     
     // Send HTML template start - broken into small chunks
     client.print("<!DOCTYPE html><html><head><meta charset=\"UTF-8\">");
@@ -745,18 +1445,19 @@ void WebGUI::streamHTML(WiFiClient& client) {
     client.print(pageTitle);
     client.print("</title><style>");
     
+    countBytes(WEBGUI_BYTES_FRAMING, tap);
+    
     // Stream minimal CSS directly 
-    client.print(WEBGUI_DEFAULT_CSS);
+    streamCSS(client);
+    countBytes(WEBGUI_BYTES_CSS, tap);
     
     client.print("</style></head><body><h1>");
     client.print(pageHeading);
     client.print("</h1>");
+    countBytes(WEBGUI_BYTES_FRAMING, tap);
     
     // Stream each element's HTML directly
-    for (GUIElement* element : elements) {
-        String elementHTML = element->generateHTML();
-        client.print(elementHTML);
-    }
+    streamElementsHTML(tap);
     
     // Stream JavaScript - minimal version
     client.print("<script>");
@@ -794,23 +1495,30 @@ void WebGUI::streamHTML(WiFiClient& client) {
     // Start auto-updating sensor displays every 100ms
     client.print("setInterval(updateSensorDisplays,100);");
     client.print("updateSensorDisplays();");
+    countBytes(WEBGUI_BYTES_SCRIPT, tap);
     
     // Stream each element's JavaScript for event handlers
     for (GUIElement* element : elements) {
-        String elementJS = element->generateJS();
-        client.print(elementJS);
+        element->streamJS(client);
+        countBytes(WEBGUI_BYTES_JS, tap, element);
     }
     
     client.print("</script></body></html>");
+    countBytes(WEBGUI_BYTES_FRAMING, tap);
 }
 
 // =====================================================
 // GUIElement Base Class Implementation  
 // =====================================================
 
-GUIElement::GUIElement(String label, int x, int y, int width, int height) 
+GUIElement::GUIElement(WebGUIText label, int x, int y, int width, int height) 
     : label(label), x(x), y(y), width(width), height(height) {
-    id = "element" + String(nextID++);
+    char idBuffer[20];  // "element" and any int
+    snprintf(idBuffer, sizeof(idBuffer), "element%d", nextID++);
+    id = idBuffer;
+#if WEBGUI_BYTE_STATS
+    memset(wireBytes, 0, sizeof(wireBytes));
+#endif
 }
 
 GUIElement::~GUIElement() {
@@ -836,11 +1544,27 @@ String GUIElement::getValue() {
     return "";
 }
 
+void GUIElement::streamHTML(Print& out) {
+    out.print(generateHTML());
+}
+
+void GUIElement::streamJS(Print& out) {
+    out.print(generateJS());
+}
+
+void GUIElement::streamValue(Print& out) {
+    out.print(getValue());
+}
+
+void GUIElement::applyUpdate(const char* value) {
+    handleUpdate(String(value));
+}
+
 // =====================================================
 // Slider Implementation
 // =====================================================
 
-Slider::Slider(String label, int x, int y, int minValue, int maxValue, int defaultValue, int width) 
+Slider::Slider(WebGUIText label, int x, int y, int minValue, int maxValue, int defaultValue, int width) 
     : GUIElement(label, x, y, width, 60), minValue(minValue), maxValue(maxValue), currentValue(defaultValue), valueChanged(false) {
 }
 
@@ -854,8 +1578,31 @@ String Slider::generateHTML() {
     return html;
 }
 
+void Slider::streamHTML(Print& out) {
+    streamTemplate(out, SLIDER_TEMPLATE, [this](Print& o, const char* name, size_t length) {
+        if (placeholderIs(name, length, "ID")) {
+            o.print(id.c_str());
+        } else if (placeholderIs(name, length, "LABEL")) {
+            o.print(label.c_str());
+        } else if (placeholderIs(name, length, "MIN")) {
+            o.print(minValue);
+        } else if (placeholderIs(name, length, "MAX")) {
+            o.print(maxValue);
+        } else if (placeholderIs(name, length, "VALUE")) {
+            o.print(currentValue);
+        } else {
+            return false;
+        }
+        return true;
+    });
+}
+
 void Slider::handleUpdate(String value) {
-    int newValue = value.toInt();
+    applyUpdate(value.c_str());
+}
+
+void Slider::applyUpdate(const char* value) {
+    int newValue = atoi(value);
     if (newValue != currentValue) {
         currentValue = constrain(newValue, minValue, maxValue);
         valueChanged = true;
@@ -866,6 +1613,10 @@ String Slider::getValue() {
     return String(currentValue);
 }
 
+void Slider::streamValue(Print& out) {
+    out.print(currentValue);
+}
+
 int Slider::getIntValue() {
     return currentValue;
 }
@@ -891,13 +1642,24 @@ String Slider::generateCSS() {
 
 String Slider::generateJS() {
     // Memory optimized: return minimal JavaScript for slider updates with value display
-    return "document.getElementById('" + id + "').oninput = function() { "
-           "document.getElementById('" + id + "_value').textContent = this.value; "
-           "updateValue('" + id + "', this.value); };\n";
+    String elementID = id;
+    return "document.getElementById('" + elementID + "').oninput = function() { "
+           "document.getElementById('" + elementID + "_value').textContent = this.value; "
+           "updateValue('" + elementID + "', this.value); };\n";
+}
+
+void Slider::streamJS(Print& out) {
+    out.print("document.getElementById('");
+    out.print(id.c_str());
+    out.print("').oninput = function() { document.getElementById('");
+    out.print(id.c_str());
+    out.print("_value').textContent = this.value; updateValue('");
+    out.print(id.c_str());
+    out.print("', this.value); };\n");
 }
 
 // Button Implementation
-Button::Button(String label, int x, int y, int width, int height) 
+Button::Button(WebGUIText label, int x, int y, int width, int height) 
     : GUIElement(label, x, y, width, height), pressed(false), pressedFlag(false), lastPressTime(0), buttonStyle("primary") {
 }
 
@@ -908,6 +1670,19 @@ String Button::generateHTML() {
     return html;
 }
 
+void Button::streamHTML(Print& out) {
+    streamTemplate(out, BUTTON_TEMPLATE, [this](Print& o, const char* name, size_t length) {
+        if (placeholderIs(name, length, "ID")) {
+            o.print(id.c_str());
+        } else if (placeholderIs(name, length, "LABEL")) {
+            o.print(label.c_str());
+        } else {
+            return false;
+        }
+        return true;
+    });
+}
+
 String Button::generateCSS() {
     // Memory optimized: return empty string since we're using minimal CSS
     return "";
@@ -918,8 +1693,16 @@ String Button::generateJS() {
     return "";
 }
 
+void Button::streamJS(Print& out) {
+    // Handled by the buttonClick function in the main JavaScript
+}
+
 void Button::handleUpdate(String value) {
-    if (value == "1") {
+    applyUpdate(value.c_str());
+}
+
+void Button::applyUpdate(const char* value) {
+    if (strcmp(value, "1") == 0) {
         pressed = !pressed;  // Toggle state on each click
         pressedFlag = true;
         lastPressTime = millis();
@@ -930,6 +1713,10 @@ String Button::getValue() {
     return pressed ? "1" : "0";
 }
 
+void Button::streamValue(Print& out) {
+    out.print(pressed ? '1' : '0');
+}
+
 bool Button::wasPressed() {
     if (pressedFlag) {
         pressedFlag = false;
@@ -956,7 +1743,7 @@ void Button::setButtonStyle(String style) {
 }
 
 // Toggle Implementation
-Toggle::Toggle(String label, int x, int y, int width) 
+Toggle::Toggle(WebGUIText label, int x, int y, int width) 
     : GUIElement(label, x, y, width, 40), state(false), stateChanged(false) {
 }
 
@@ -966,13 +1753,26 @@ String Toggle::generateHTML() {
     html.replace("%LABEL%", label);
     
     // Set initial checkbox state based on current toggle state
-    if (state) {
-        html.replace("type=\"checkbox\"", "type=\"checkbox\" checked");
-    }
+    html.replace("%CHECKED%", state ? " checked" : "");
     
     return html;
 }
 
+void Toggle::streamHTML(Print& out) {
+    streamTemplate(out, TOGGLE_TEMPLATE, [this](Print& o, const char* name, size_t length) {
+        if (placeholderIs(name, length, "ID")) {
+            o.print(id.c_str());
+        } else if (placeholderIs(name, length, "LABEL")) {
+            o.print(label.c_str());
+        } else if (placeholderIs(name, length, "CHECKED")) {
+            if (state) o.print(" checked");
+        } else {
+            return false;
+        }
+        return true;
+    });
+}
+
 String Toggle::generateCSS() {
     // Memory optimized: return empty string since we're using minimal CSS
     return "";
@@ -983,8 +1783,16 @@ String Toggle::generateJS() {
     return "";
 }
 
+void Toggle::streamJS(Print& out) {
+    // Handled by the toggleChange function in the main JavaScript
+}
+
 void Toggle::handleUpdate(String value) {
-    bool newState = (value == "1" || value == "true");
+    applyUpdate(value.c_str());
+}
+
+void Toggle::applyUpdate(const char* value) {
+    bool newState = (strcmp(value, "1") == 0 || strcmp(value, "true") == 0);
     if (newState != state) {
         state = newState;
         stateChanged = true;
@@ -995,6 +1803,10 @@ String Toggle::getValue() {
     return state ? "1" : "0";
 }
 
+void Toggle::streamValue(Print& out) {
+    out.print(state ? '1' : '0');
+}
+
 bool Toggle::isOn() {
     return state;
 }
@@ -1017,7 +1829,7 @@ void Toggle::resetToggle() {
 }
 
 // TextBox Implementation
-TextBox::TextBox(String label, int x, int y, int width, String placeholder) 
+TextBox::TextBox(WebGUIText label, int x, int y, int width, WebGUIText placeholder) 
     : GUIElement(label, x, y, width, 30), textValue(""), placeholderText(placeholder), valueChanged(false), lastValue("") {
 }
 
@@ -1030,6 +1842,23 @@ String TextBox::generateHTML() {
     return html;
 }
 
+void TextBox::streamHTML(Print& out) {
+    streamTemplate(out, TEXTBOX_TEMPLATE, [this](Print& o, const char* name, size_t length) {
+        if (placeholderIs(name, length, "ID")) {
+            o.print(id.c_str());
+        } else if (placeholderIs(name, length, "LABEL")) {
+            o.print(label.c_str());
+        } else if (placeholderIs(name, length, "VALUE")) {
+            o.print(textValue.c_str());
+        } else if (placeholderIs(name, length, "PLACEHOLDER")) {
+            o.print(placeholderText.c_str());
+        } else {
+            return false;
+        }
+        return true;
+    });
+}
+
 String TextBox::generateCSS() {
     // Memory optimized: return empty string since we're using minimal CSS
     return "";
@@ -1040,7 +1869,15 @@ String TextBox::generateJS() {
     return "";  // No individual JS needed, handled by global textboxChange function
 }
 
+void TextBox::streamJS(Print& out) {
+    // Handled by the global textboxChange function
+}
+
 void TextBox::handleUpdate(String value) {
+    applyUpdate(value.c_str());
+}
+
+void TextBox::applyUpdate(const char* value) {
     lastValue = textValue;
     textValue = value;
     valueChanged = (lastValue != textValue);
@@ -1050,6 +1887,10 @@ String TextBox::getValue() {
     return textValue;
 }
 
+void TextBox::streamValue(Print& out) {
+    out.print(textValue.c_str());
+}
+
 void TextBox::setValue(String value) {
     textValue = value;
     valueChanged = false;
@@ -1120,7 +1961,7 @@ void TextBox::setIPAddress(const String& ip) {
     if (isValidIPAddress(ip)) {
         setValue(ip);
     } else {
-        Serial.println("Warning: Invalid IP address format: " + ip);
+        WEBGUI_LOG_WARN("Warning: Invalid IP address format: ", ip);
         // Don't set invalid IP, keep current value
     }
 }
@@ -1170,18 +2011,34 @@ String TextBox::formatIPDisplay(const String& ip, const String& subnet, const St
 }
 
 // SensorStatus Implementation
-SensorStatus::SensorStatus(String label, int x, int y, int width) 
-    : GUIElement(label, x, y, width, 40), displayValue("0") {
+SensorStatus::SensorStatus(WebGUIText label, int x, int y, int width) 
+    : GUIElement(label, x, y, width, 40), valueType(VALUE_TEXT), decimals(0), formatPending(false), displayValue("0") {
+    raw.intValue = 0;
 }
 
 String SensorStatus::generateHTML() {
     String html = String(SENSOR_STATUS_TEMPLATE);
     html.replace("%ID%", id);
     html.replace("%LABEL%", label);
-    html.replace("%VALUE%", displayValue);
+    html.replace("%VALUE%", formatValue());
     return html;
 }
 
+void SensorStatus::streamHTML(Print& out) {
+    streamTemplate(out, SENSOR_STATUS_TEMPLATE, [this](Print& o, const char* name, size_t length) {
+        if (placeholderIs(name, length, "ID")) {
+            o.print(id.c_str());
+        } else if (placeholderIs(name, length, "LABEL")) {
+            o.print(label.c_str());
+        } else if (placeholderIs(name, length, "VALUE")) {
+            o.print(formatValue());
+        } else {
+            return false;
+        }
+        return true;
+    });
+}
+
 String SensorStatus::generateCSS() {
     // Memory optimized: return empty string since we're using minimal CSS
     return "";
@@ -1192,41 +2049,271 @@ String SensorStatus::generateJS() {
     return "";
 }
 
+void SensorStatus::streamJS(Print& out) {
+    // SensorStatus is read-only, no JavaScript needed
+}
+
 void SensorStatus::handleUpdate(String value) {
+    applyUpdate(value.c_str());
+}
+
+void SensorStatus::applyUpdate(const char* value) {
     // Allow updating the display value (useful for reset operations)
-    displayValue = value;
+    setValue(value);
 }
 
 String SensorStatus::getValue() {
-    return displayValue;
+    return formatValue();
+}
+
+String SensorStatus::getDisplayValue() {
+    return formatValue();
+}
+
+void SensorStatus::streamValue(Print& out) {
+    out.print(formatValue());
+}
+
+// Only records the value; formatting waits until a client reads it
+void SensorStatus::setRaw(ValueType type, long intValue, float floatValue, bool boolValue, uint8_t newDecimals) {
+    bool same = false;
+    if (type == valueType) {
+        switch (type) {
+            case VALUE_INT:   same = raw.intValue == intValue; break;
+            case VALUE_FLOAT: same = raw.floatValue == floatValue && decimals == newDecimals; break;
+            case VALUE_BOOL:  same = raw.boolValue == boolValue; break;
+            default: break;
+        }
+    }
+    if (same) {
+        return;
+    }
+    
+    valueType = type;
+    decimals = newDecimals;
+    switch (type) {
+        case VALUE_INT:   raw.intValue = intValue; break;
+        case VALUE_FLOAT: raw.floatValue = floatValue; break;
+        case VALUE_BOOL:  raw.boolValue = boolValue; break;
+        default: break;
+    }
+    formatPending = true;
+}
+
+#if WEBGUI_INLINE_STRINGS
+static const size_t SENSOR_VALUE_ROOM = WEBGUI_SENSOR_VALUE_CAPACITY;
+#else
+static const size_t SENSOR_VALUE_ROOM = WEBGUI_FLOAT_BUFFER_SIZE;  // A String takes any float
+#endif
+
+// Brings displayValue up to date; assigning into it reuses its storage
+const char* SensorStatus::formatValue() {
+    if (formatPending) {
+        char buffer[WEBGUI_FLOAT_BUFFER_SIZE];
+        switch (valueType) {
+            case VALUE_INT:
+                webguiFormatInt(buffer, raw.intValue);
+                displayValue = buffer;
+                break;
+            case VALUE_FLOAT:
+                // Drop decimals rather than let a large value be cut short
+                for (int d = decimals; webguiFormatFloat(buffer, raw.floatValue, d) > SENSOR_VALUE_ROOM && d > 0; d--) {
+                }
+                displayValue = buffer;
+                break;
+            case VALUE_BOOL:
+                displayValue = raw.boolValue ? "true" : "false";
+                break;
+            default:
+                break;
+        }
+        formatPending = false;
+    }
+    return displayValue.c_str();
 }
 
 void SensorStatus::setValue(int value) {
-    displayValue = String(value);
+    setRaw(VALUE_INT, value, 0, false, 0);
 }
 
 void SensorStatus::setValue(float value, int decimals) {
-    displayValue = String(value, decimals);
+    setRaw(VALUE_FLOAT, 0, value, false, constrain(decimals, 0, 7));
 }
 
 void SensorStatus::setValue(bool value) {
-    displayValue = value ? "true" : "false";
+    setRaw(VALUE_BOOL, 0, 0, value, 0);
 }
 
 void SensorStatus::setValue(String value) {
-    displayValue = value;
+    setValue(value.c_str());
 }
 
 void SensorStatus::setValue(const char* value) {
-    displayValue = String(value);
+    valueType = VALUE_TEXT;
+    formatPending = false;
+    displayValue = value;
+}
+
+// SystemStatus Implementation
+SystemStatus::SystemStatus(WebGUIText label, int x, int y, int width) 
+    : GUIElement(label, x, y, width, 80), freeMemory(-1), uptime(0), uptimeSet(false),
+      statsTime(0), statsValid(false) {
+}
+
+String SystemStatus::generateHTML() {
+    String html = String(SYSTEM_STATUS_TEMPLATE);
+    html.replace("%ID%", id);
+    html.replace("%LABEL%", label);
+    html.replace("%VALUE%", getValue());
+    return html;
+}
+
+void SystemStatus::streamHTML(Print& out) {
+    streamTemplate(out, SYSTEM_STATUS_TEMPLATE, [this](Print& o, const char* name, size_t length) {
+        if (placeholderIs(name, length, "ID")) {
+            o.print(id.c_str());
+        } else if (placeholderIs(name, length, "LABEL")) {
+            o.print(label.c_str());
+        } else if (placeholderIs(name, length, "VALUE")) {
+            streamInfo(o);
+        } else {
+            return false;
+        }
+        return true;
+    });
+}
+
+String SystemStatus::generateCSS() {
+    // Memory optimized: return empty string since we're using minimal CSS
+    return "";
+}
+
+String SystemStatus::generateJS() {
+    // SystemStatus is read-only, no JavaScript needed
+    return "";
+}
+
+void SystemStatus::streamJS(Print& out) {
+    // SystemStatus is read-only, no JavaScript needed
+}
+
+void SystemStatus::handleUpdate(String value) {
+    // Read-only
+}
+
+void SystemStatus::applyUpdate(const char* value) {
+    // Read-only
+}
+
+String SystemStatus::getValue() {
+    String info;
+    WebGUIStringPrint out(info);
+    streamInfo(out);
+    return info;
+}
+
+void SystemStatus::streamValue(Print& out) {
+    streamInfo(out);
+}
+
+void SystemStatus::updateMemory(int freeBytes) {
+    freeMemory = freeBytes;
+}
+
+void SystemStatus::updateUptime(unsigned long uptimeSeconds) {
+    uptime = uptimeSeconds;
+    uptimeSet = true;
+}
+
+void SystemStatus::updateSystemInfo(int freeBytes, unsigned long uptimeSeconds) {
+    updateMemory(freeBytes);
+    updateUptime(uptimeSeconds);
+}
+
+// "Heap: 182.3 KB free, 110.0 KB block, 170.1 KB min | Stack: 1.2 KB free | Uptime: 1d 02:03:04"
+void SystemStatus::streamInfo(Print& out) {
+    if (freeMemory >= 0) {
+        out.print("Free memory: ");
+        streamMemory(out, (uint32_t)freeMemory);
+    } else {
+        // getMemoryStats() scans the stack, so don't repeat it for every poll
+        if (!statsValid || millis() - statsTime >= 1000) {
+            stats = getMemoryStats();
+            statsTime = millis();
+            statsValid = true;
+        }
+        out.print("Heap: ");
+        streamMemory(out, stats.freeHeap);
+        out.print(" free, ");
+        streamMemory(out, stats.largestFreeBlock);
+        out.print(" block, ");
+        streamMemory(out, stats.minFreeHeap);
+        out.print(" min | Stack: ");
+        streamMemory(out, stats.stackHighWaterMark);
+        out.print(" free");
+    }
+    out.print(" | Uptime: ");
+    streamUptime(out, uptimeSet ? uptime : millis() / 1000);
+}
+
+void SystemStatus::streamMemory(Print& out, uint32_t bytes) {
+    if (bytes < 1024) {
+        out.print(bytes);
+        out.print(" B");
+    } else {
+        out.print(bytes / 1024);
+        out.print('.');
+        out.print((bytes % 1024) * 10 / 1024);
+        out.print(" KB");
+    }
+}
+
+void SystemStatus::streamUptime(Print& out, unsigned long seconds) {
+    unsigned long days = seconds / 86400;
+    unsigned int hours = (seconds / 3600) % 24;
+    unsigned int minutes = (seconds / 60) % 60;
+    unsigned int secs = seconds % 60;
+    if (days > 0) {
+        out.print(days);
+        out.print("d ");
+    }
+    if (hours < 10) out.print('0');
+    out.print(hours);
+    out.print(':');
+    if (minutes < 10) out.print('0');
+    out.print(minutes);
+    out.print(':');
+    if (secs < 10) out.print('0');
+    out.print(secs);
+}
+
+String SystemStatus::formatUptime(unsigned long seconds) {
+    String text;
+    WebGUIStringPrint out(text);
+    streamUptime(out, seconds);
+    return text;
+}
+
+String SystemStatus::formatMemory(int bytes) {
+    String text;
+    WebGUIStringPrint out(text);
+    streamMemory(out, (uint32_t)bytes);
+    return text;
 }
 
 // ============================================================================
 // Persistent Settings Implementation
 // ============================================================================
 
+#if !defined(ESP32) && !defined(ARDUINO_SAMD_NANO_33_IOT)
+// EEPROM layout: 100 hashed 16-byte slots per type, strings from 16, ints
+// from 1616, floats from 3216 and bools from 4816
+static const int EEPROM_SETTINGS_END = 4816 + 100 * 16;
+#endif
+
 void WebGUI::initSettings() {
     if (settingsInitialized) return;
+    unsigned long phaseStart = millis();
     
 #if defined(ESP32)
     // Initialize ESP32 Preferences
@@ -1243,10 +2330,12 @@ void WebGUI::initSettings() {
 #endif
     
     settingsInitialized = true;
+    boot.record(WEBGUI_BOOT_SETTINGS, phaseStart);
 }
 
 void WebGUI::saveSetting(const char* key, int value) {
     if (!settingsInitialized) initSettings();
+    metrics.settingWritten();
     
 #if defined(ESP32)
     static_cast<Preferences*>(preferences)->putInt(key, value);
@@ -1288,6 +2377,7 @@ void WebGUI::saveSetting(const char* key, int value) {
 
 void WebGUI::saveSetting(const char* key, float value) {
     if (!settingsInitialized) initSettings();
+    metrics.settingWritten();
     
 #if defined(ESP32)
     static_cast<Preferences*>(preferences)->putFloat(key, value);
@@ -1327,6 +2417,7 @@ void WebGUI::saveSetting(const char* key, float value) {
 
 void WebGUI::saveSetting(const char* key, bool value) {
     if (!settingsInitialized) initSettings();
+    metrics.settingWritten();
     
 #if defined(ESP32)
     static_cast<Preferences*>(preferences)->putBool(key, value);
@@ -1355,17 +2446,18 @@ void WebGUI::saveSetting(const char* key, bool value) {
         flash_settings.write(settings);
     }
 #else
-    uint16_t addr = 16;
+    uint16_t hash = 0;
     for (int i = 0; key[i] != '\0'; i++) {
-        addr += key[i];
+        hash = hash * 31 + key[i];
     }
-    addr = (addr % 1000) + 16;
+    uint16_t addr = 4816 + (hash % 100) * 16;  // After the float slots
     EEPROM.put(addr, value);
 #endif
 }
 
 void WebGUI::saveSetting(const char* key, const char* value) {
     if (!settingsInitialized) initSettings();
+    metrics.settingWritten();
     
 #if defined(ESP32)
     static_cast<Preferences*>(preferences)->putString(key, value);
@@ -1411,6 +2503,7 @@ void WebGUI::saveSetting(const char* key, const char* value) {
 
 int WebGUI::loadIntSetting(const char* key) {
     if (!settingsInitialized) initSettings();
+    WebGUIBootSettingsRead timing(boot);
     
 #if defined(ESP32)
     return static_cast<Preferences*>(preferences)->getInt(key, 0);
@@ -1438,6 +2531,7 @@ int WebGUI::loadIntSetting(const char* key) {
 
 float WebGUI::loadFloatSetting(const char* key) {
     if (!settingsInitialized) initSettings();
+    WebGUIBootSettingsRead timing(boot);
     
 #if defined(ESP32)
     return static_cast<Preferences*>(preferences)->getFloat(key, 0.0);
@@ -1465,6 +2559,7 @@ float WebGUI::loadFloatSetting(const char* key) {
 
 bool WebGUI::loadBoolSetting(const char* key) {
     if (!settingsInitialized) initSettings();
+    WebGUIBootSettingsRead timing(boot);
     
 #if defined(ESP32)
     return static_cast<Preferences*>(preferences)->getBool(key, false);
@@ -1483,15 +2578,14 @@ bool WebGUI::loadBoolSetting(const char* key) {
     for (int i = 0; key[i] != '\0'; i++) {
         hash = hash * 31 + key[i];
     }
-    uint16_t addr = 16 + (hash % 200) * 8;
-    bool value;
-    EEPROM.get(addr, value);
-    return value;
+    uint16_t addr = 4816 + (hash % 100) * 16;  // Match saveSetting address
+    return EEPROM.read(addr) == 1;  // Erased EEPROM reads 0xFF
 #endif
 }
 
 String WebGUI::loadStringSetting(const char* key) {
     if (!settingsInitialized) initSettings();
+    WebGUIBootSettingsRead timing(boot);
     
 #if defined(ESP32)
     return static_cast<Preferences*>(preferences)->getString(key, "");
@@ -1524,31 +2618,33 @@ String WebGUI::loadStringSetting(const char* key) {
 }
 
 void WebGUI::clearMemory() {
+    metrics.settingWritten();
 #if defined(ESP32) || defined(ESP8266)
     // For ESP32/ESP8266 - Clear all Preferences
     if (preferences) {
         static_cast<Preferences*>(preferences)->clear();
-        Serial.println("✅ ESP32 Preferences cleared");
+        WEBGUI_LOG_INFO("✅ ESP32 Preferences cleared");
     }
 #elif defined(ARDUINO_SAMD_NANO_33_IOT)
     // For Nano 33 IoT - Clear FlashStorage
     FlashSettings settings;
     memset(&settings, 0, sizeof(settings));
     flash_settings.write(settings);
-    Serial.println("✅ Nano 33 IoT Flash Storage cleared");
+    WEBGUI_LOG_INFO("✅ Nano 33 IoT Flash Storage cleared");
 #else
     // For Arduino UNO R4 WiFi and other EEPROM-based systems
-    // Clear first 1024 bytes of EEPROM (more than enough for most applications)
-    for (int i = 0; i < 1024; i++) {
-        EEPROM.write(i, 0xFF); // 0xFF is the erased state for EEPROM
+    // Clear every settings slot, bools included; bytes already erased are
+    // left alone to spare the EEPROM
+    for (int i = 0; i < EEPROM_SETTINGS_END; i++) {
+        EEPROM.update(i, 0xFF); // 0xFF is the erased state for EEPROM
     }
     #if defined(ARDUINO_UNOR4_WIFI)
         // Arduino UNO R4 WiFi doesn't require EEPROM.commit()
-        Serial.println("✅ Arduino UNO R4 WiFi EEPROM cleared (1024 bytes)");
+        WEBGUI_LOG_INFO("✅ Arduino UNO R4 WiFi EEPROM cleared (", EEPROM_SETTINGS_END, " bytes)");
     #else
         // Other Arduino platforms may need commit
         EEPROM.commit();
-        Serial.println("✅ Arduino EEPROM cleared (1024 bytes)");
+        WEBGUI_LOG_INFO("✅ Arduino EEPROM cleared (", EEPROM_SETTINGS_END, " bytes)");
     #endif
 #endif
 }
@@ -1557,17 +2653,8 @@ void WebGUI::clearMemory() {
 
 // Cross-platform function to get available RAM
 int getFreeRAM() {
-#ifdef ARDUINO_UNOR4_WIFI
-    // For Arduino UNO R4 WiFi (Renesas RA platform)
-    // Simple stack-based approximation
-    char dummy;
-    return (int)&dummy - 0x20000000; // Approximate available stack space
-#else
-    // For AVR-based Arduinos (UNO, Nano, etc.)
-    extern int __heap_start, *__brkval;
-    int v;
-    return (int) &v - (__brkval == 0 ? (int) &__heap_start : (int) __brkval);
-#endif
+    // Platform implementations live in WebGUIMemory.cpp
+    return (int)getFreeHeap();
 }
 
 // Cross-platform function to clear all stored memory/settings
@@ -18,9 +18,29 @@
 #define WebGUI_h
 
 #include "Arduino.h"
-#include <vector>
+#include "WebGUIConfig.h"
+#include "WebGUIString.h"
+#include "WebGUIArena.h"
+#include "WebGUIElementList.h"
+#include "WebGUIMemory.h"
+#include "WebGUIAllocStats.h"
+#include "WebGUIFormat.h"
+#include "WebGUIMetrics.h"
+#include "WebGUITrace.h"
+#include "WebGUIBoot.h"
+#include "WebGUICapture.h"
+#include "WebGUILog.h"
+#include "WebGUIByteStats.h"
 #include "WebGUIStyles.h"
 
+// ESP32 serves through the WebServer library, except in zero-heap mode where
+// it uses the same WiFiServer loop as the other boards
+#if defined(ESP32) && !WEBGUI_ZERO_HEAP
+  #define WEBGUI_USE_WEBSERVER 1
+#else
+  #define WEBGUI_USE_WEBSERVER 0
+#endif
+
 // Platform-specific includes
 #if defined(ARDUINO_UNOWIFIR4)
   #include <WiFiS3.h>
@@ -30,8 +50,12 @@
   #define WEBGUI_WIFI_TYPE WiFiServer
 #elif defined(ESP32)
   #include <WiFi.h>
-  #include <WebServer.h>
-  #define WEBGUI_WIFI_TYPE WebServer
+  #if WEBGUI_USE_WEBSERVER
+    #include <WebServer.h>
+    #define WEBGUI_WIFI_TYPE WebServer
+  #else
+    #define WEBGUI_WIFI_TYPE WiFiServer
+  #endif
 #else
   #error "Unsupported board! This library supports Arduino UNO R4 WiFi, Arduino Nano 33 IoT, and ESP32"
 #endif
@@ -45,6 +69,10 @@ class SensorStatus;
 class SystemStatus;
 class TextBox;
 
+// Called after an update() call that took longer than the threshold given
+// to onSlowUpdate(); route is the request it served, if any
+typedef void (*WebGUISlowUpdateCallback)(uint32_t micros, WebGUIRoute route);
+
 class WebGUI {
   public:
     WebGUI(int port = 80);
@@ -52,7 +80,7 @@ class WebGUI {
     
     void begin();
     void update();
-    void addElement(GUIElement* element);
+    bool addElement(GUIElement* element);  // false if WEBGUI_MAX_ELEMENTS is reached
     void handleRequest();
     
     // Access point configuration
@@ -75,7 +103,7 @@ class WebGUI {
     void restartDevice();
     
     // Style management
-    void setCustomCSS(const char* customCSS);
+    void setCustomCSS(WebGUIText customCSS);  // Added after the default styles
     void setTheme(const WebGUITheme& theme);
     void useDefaultStyles();
     
@@ -99,14 +127,90 @@ class WebGUI {
     // Element management
     GUIElement* findElementByID(const String& id);
     
+    // The page and the /get JSON as a request for them would be answered,
+    // for front ends that serve copies (the host build's gateway). Not a
+    // request: nothing goes into the metrics, trace, capture, byte counts
+    // or update times, and save status elements are left as they are.
+    void renderPage(Print& out);
+    void renderValues(Print& out);
+    
+    // Request memory: the most arena space any request has used so far
+    size_t getRequestArenaPeak() { return requestArena.getPeak(); }
+    size_t getRequestArenaSize() { return requestArena.getCapacity(); }
+    unsigned long getRequestArenaFailures() { return requestArena.getFailures(); }
+    
+    // Load shedding under memory pressure (see WEBGUI_SHED_PAGES_BELOW)
+    bool isSheddingLoad() { return loadShedLevel != SHED_NONE; }
+    unsigned long getShedPageRequests() { return shedPageRequests; }
+    unsigned long getRefusedConnections() { return refusedConnections; }  // Arduino boards; ESP32 leaves them queued
+    
+    // Loop blocking: how long each update() call held the sketch's loop, in us
+    const WebGUIHistogram& getUpdateTimes() { return updateTimes; }
+    uint32_t getMaxUpdateTime() { return updateTimes.getMax(); }
+    uint32_t getUpdateTimeP99() { return updateTimes.percentile(0.99f); }
+    void resetUpdateTimes() { updateTimes.reset(); }
+    void onSlowUpdate(uint32_t thresholdMicros, WebGUISlowUpdateCallback callback);
+    
+    // The last WEBGUI_TRACE_SIZE requests with their timings, oldest first;
+    // also served at /debug/trace
+    void dumpTrace(Print& out) { trace.dump(out); }
+#if WEBGUI_TRACE_SIZE > 0
+    const WebGUITrace& getTrace() { return trace; }
+#endif
+    
+    // When each startup phase ran and when the first page was served;
+    // also served at /debug/boot
+    void dumpBootReport(Print& out) { boot.dump(out); }
+#if WEBGUI_BOOT_TIMELINE_SIZE > 0
+    const WebGUIBootTimeline& getBootTimeline() { return boot; }
+#endif
+    
+    // Raw requests as they arrived, for the host build's replay tool
+    // (WEBGUI_CAPTURE_SIZE); also served at /debug/capture
+    void startCapture() { capture.start(); }
+    void stopCapture() { capture.stop(); }
+    void clearCapture() { capture.clear(); }
+    void dumpCapture(Print& out) { capture.dump(out); }
+#if WEBGUI_CAPTURE_SIZE > 0
+    const WebGUICapture& getCapture() { return capture; }
+#endif
+    
+    // Response bytes per part of the page and /get, and per element
+    // (WEBGUI_BYTE_STATS); also served at /metrics
+    const WebGUIByteStats& getByteStats() { return byteStats; }
+    void resetByteStats();
+    void dumpByteStats(Print& out);
+    
+#if WEBGUI_METRICS
+    // Request, latency and byte counters, also served at /metrics
+    const WebGUIMetrics& getMetrics() { return metrics; }
+#endif
+    
   private:
     WEBGUI_WIFI_TYPE* server;
-    std::vector<GUIElement*> elements;
+    WebGUIElementList elements;
     int serverPort;
     bool apMode;
-    String httpRequest;
-    String customCSS;
-    bool useCustomStyles;
+    WebGUIArena requestArena;  // Request-scoped scratch memory, reset after each response
+    
+    // Load shedding state, re-evaluated at the start of every update()
+    enum LoadShedLevel : uint8_t { SHED_NONE, SHED_PAGES, SHED_CONNECTIONS };
+    LoadShedLevel loadShedLevel;
+    unsigned long shedPageRequests;
+    unsigned long refusedConnections;
+    void updateLoadShedding();
+    WebGUIMetrics metrics;
+    WebGUITrace trace;
+    WebGUIBootTimeline boot;
+    WebGUICapture capture;
+    WebGUIByteStats byteStats;
+    bool countingBytes;       // Off while rendering for renderPage()/renderValues()
+    WebGUIHistogram updateTimes;
+    WebGUIRoute updateRoute;  // Request served by the current update() call
+    uint32_t slowUpdateThreshold;
+    WebGUISlowUpdateCallback slowUpdateCallback;
+    WebGUIConstText<String> customCSS;  // Borrowed from flash unless set from RAM
+    WebGUITheme theme;
     String pageTitle;
     String pageHeading;
     
@@ -130,22 +234,40 @@ class WebGUI {
     void handleRoot();
     void handleSet();
     void handleGet();
+    void handleMetrics();
+    void handleTrace();
+    void handleLog();
+    void handleBoot();
+    void handleCapture();
+    
+#if WEBGUI_USE_WEBSERVER
+    // Writes a /metrics or /debug report to the response
+    typedef void (*DebugTextWriter)(WebGUI& gui, Print& out);
+    void serveDebugText(WebGUIRoute route, const char* contentType, DebugTextWriter writer);
+#endif
+    
+    bool waitForWiFi(bool dhcp);
+    void pageServed();
     
-#if !defined(ESP32)
+#if !WEBGUI_USE_WEBSERVER
     void processClient();
-    void handleSetRequest(String request);
-    String generateGetResponse();
+    void handleSetRequest(char* query);
 #endif
     
-    String generateHTML();
-    void streamHTML(WiFiClient& client);  // MEMORY OPTIMIZED: Stream instead of build large strings
-    String generateCSS();
-    String generateJS();
+    void resetSaveStatusElements();
+    void streamGetResponse(Print& out);
+    void streamMetrics(Print& out);
+    void streamTemplateHTML(Print& out);  // Full page template (ESP32)
+    void streamHTML(Print& out);  // MEMORY OPTIMIZED: Stream instead of build large strings
+    void streamCSS(Print& out);
+    void streamJS(WebGUIByteTap& out);
+    void streamElementsHTML(WebGUIByteTap& out);
+    void countBytes(WebGUIBytesPart part, WebGUIByteTap& tap, GUIElement* element = nullptr);
 };
 
 class GUIElement {
   public:
-    GUIElement(String label, int x, int y, int width = 200, int height = 30);
+    GUIElement(WebGUIText label, int x, int y, int width = 200, int height = 30);
     virtual ~GUIElement();
     
     virtual String generateHTML() = 0;
@@ -154,9 +276,22 @@ class GUIElement {
     virtual void handleUpdate(String value) = 0;
     virtual String getValue() = 0;
     
+    // Allocation-free versions used by the server. The defaults fall back to
+    // the String methods above, so custom elements work without overriding them.
+    virtual void streamHTML(Print& out);
+    virtual void streamJS(Print& out);
+    virtual void streamValue(Print& out);
+    virtual void applyUpdate(const char* value);
+    
+    // Names the element in byte accounting; custom elements may override
+    virtual const char* getTypeName() { return "custom"; }
+    
     String getID() { return id; }
+    const char* getIDCStr() { return id.c_str(); }
+    bool hasID(const char* candidate) { return strcmp(id.c_str(), candidate) == 0; }
     String getLabel() { return label; }
-    void setLabel(String newLabel) { label = newLabel; }
+    const char* getLabelCStr() { return label.c_str(); }
+    void setLabel(WebGUIText newLabel) { label = newLabel; }
     int getX() { return x; }
     int getY() { return y; }
     int getWidth() { return width; }
@@ -165,27 +300,44 @@ class GUIElement {
     void setPosition(int newX, int newY);
     void setSize(int newWidth, int newHeight);
     
+#if WEBGUI_BYTE_STATS
+    // Response bytes this element produced: WEBGUI_BYTES_HTML, _JS or _VALUE
+    uint32_t getWireBytes(WebGUIBytesPart part) { return wireBytes[part]; }
+#endif
+    
   protected:
-    String id;
-    String label;
+    WebGUIIDString id;
+    WebGUILabelText label;       // Borrowed from flash until setLabel() is called
     int x, y, width, height;
     static int nextID;
     
     String generateBaseCSS();
+    
+#if WEBGUI_BYTE_STATS
+  private:
+    friend class WebGUI;
+    uint32_t wireBytes[WEBGUI_ELEMENT_BYTES_PARTS];
+#endif
 };
 
 class Button : public GUIElement {
   public:
-    Button(String label, int x, int y, int width = 100, int height = 40);
+    Button(WebGUIText label, int x, int y, int width = 100, int height = 40);
     
     String generateHTML() override;
     String generateCSS() override;
     String generateJS() override;
     void handleUpdate(String value) override;
     String getValue() override;
+    void streamHTML(Print& out) override;
+    void streamJS(Print& out) override;
+    void streamValue(Print& out) override;
+    void applyUpdate(const char* value) override;
+    const char* getTypeName() override { return "Button"; }
     
     bool wasPressed();
     bool isPressed();
+    unsigned long getLastPressTime() { return lastPressTime; }  // millis() of the last press, 0 if none
     void setState(bool state);  // Set toggle state for visual feedback
     
     // Style options
@@ -195,20 +347,25 @@ class Button : public GUIElement {
     bool pressed;
     bool pressedFlag;
     unsigned long lastPressTime;
-    String buttonStyle;
+    WebGUIButtonStyleString buttonStyle;
     
     void resetPress();
 };
 
 class Toggle : public GUIElement {
   public:
-    Toggle(String label, int x, int y, int width = 200);
+    Toggle(WebGUIText label, int x, int y, int width = 200);
     
     String generateHTML() override;
     String generateCSS() override;
     String generateJS() override;
     void handleUpdate(String value) override;
     String getValue() override;
+    void streamHTML(Print& out) override;
+    void streamJS(Print& out) override;
+    void streamValue(Print& out) override;
+    void applyUpdate(const char* value) override;
+    const char* getTypeName() override { return "Toggle"; }
     
     bool isOn();
     bool wasToggled();
@@ -226,13 +383,18 @@ class Toggle : public GUIElement {
 
 class Slider : public GUIElement {
   public:
-    Slider(String label, int x, int y, int minValue, int maxValue, int defaultValue, int width = 300);
+    Slider(WebGUIText label, int x, int y, int minValue, int maxValue, int defaultValue, int width = 300);
     
     String generateHTML() override;
     String generateCSS() override;
     String generateJS() override;
     void handleUpdate(String value) override;
     String getValue() override;
+    void streamHTML(Print& out) override;
+    void streamJS(Print& out) override;
+    void streamValue(Print& out) override;
+    void applyUpdate(const char* value) override;
+    const char* getTypeName() override { return "Slider"; }
     
     int getIntValue();
     float getFloatValue();
@@ -257,40 +419,68 @@ class Slider : public GUIElement {
 
 class SensorStatus : public GUIElement {
   public:
-    SensorStatus(String label, int x, int y, int width = 200);
+    SensorStatus(WebGUIText label, int x, int y, int width = 200);
     
     String generateHTML() override;
     String generateCSS() override;
     String generateJS() override;
     void handleUpdate(String value) override; // Not used - read-only
     String getValue() override;
+    void streamHTML(Print& out) override;
+    void streamJS(Print& out) override;
+    void streamValue(Print& out) override;
+    void applyUpdate(const char* value) override;
+    const char* getTypeName() override { return "SensorStatus"; }
     
     // Set values for different data types
     void setValue(int value);
+    // decimals is clamped to 0-7. With inline strings, decimals are dropped
+    // until the value fits WEBGUI_SENSOR_VALUE_CAPACITY; one whose integer
+    // part alone is longer is truncated.
     void setValue(float value, int decimals = 2);
     void setValue(bool value);
     void setValue(String value);
     void setValue(const char* value);
     
     // Get current display value
-    String getDisplayValue() { return displayValue; }
+    String getDisplayValue();
     
     // Calculate proper height for positioning
     static int getRequiredHeight() { return 40; }
     
   private:
-    String displayValue;
+    enum ValueType : uint8_t { VALUE_INT, VALUE_FLOAT, VALUE_BOOL, VALUE_TEXT };
+    
+    // Numbers are stored as set and only formatted when a client asks,
+    // at most once per change; text is kept in displayValue directly
+    union {
+        long intValue;
+        float floatValue;
+        bool boolValue;
+    } raw;
+    ValueType valueType;
+    uint8_t decimals;
+    bool formatPending;                   // raw changed since displayValue was written
+    WebGUISensorValueString displayValue;
+    
+    void setRaw(ValueType type, long intValue, float floatValue, bool boolValue, uint8_t decimals);
+    const char* formatValue();
 };
 
 class TextBox : public GUIElement {
   public:
-    TextBox(String label, int x, int y, int width = 200, String placeholder = "");
+    TextBox(WebGUIText label, int x, int y, int width = 200, WebGUIText placeholder = "");
     
     String generateHTML() override;
     String generateCSS() override;
     String generateJS() override;
     void handleUpdate(String value) override;
     String getValue() override;
+    void streamHTML(Print& out) override;
+    void streamJS(Print& out) override;
+    void streamValue(Print& out) override;
+    void applyUpdate(const char* value) override;
+    const char* getTypeName() override { return "TextBox"; }
     
     // Set/get text value
     void setValue(String value);
@@ -300,7 +490,7 @@ class TextBox : public GUIElement {
     bool wasChanged();
     
     // Set placeholder text
-    void setPlaceholder(String placeholder) { placeholderText = placeholder; }
+    void setPlaceholder(WebGUIText placeholder) { placeholderText = placeholder; }
     
     // IP Address helper methods
     bool isValidIPAddress();
@@ -317,23 +507,29 @@ class TextBox : public GUIElement {
     static int getRequiredHeight() { return 30; }
     
   private:
-    String textValue;
-    String placeholderText;
+    WebGUITextBoxString textValue;
+    WebGUIPlaceholderText placeholderText;
     bool valueChanged;
-    String lastValue;
+    WebGUITextBoxString lastValue;
 };
 
 class SystemStatus : public GUIElement {
   public:
-    SystemStatus(String label, int x, int y, int width = 350);
+    SystemStatus(WebGUIText label, int x, int y, int width = 350);
     
     String generateHTML() override;
     String generateCSS() override;
     String generateJS() override;
     void handleUpdate(String value) override; // Not used - read-only
     String getValue() override;
-    
-    // Update system information
+    void streamHTML(Print& out) override;
+    void streamJS(Print& out) override;
+    void streamValue(Print& out) override;
+    void applyUpdate(const char* value) override; // Not used - read-only
+    const char* getTypeName() override { return "SystemStatus"; }
+    
+    // Update system information. Until these are called the element shows
+    // live heap, stack and uptime figures from getMemoryStats().
     void updateMemory(int freeBytes);
     void updateUptime(unsigned long uptimeSeconds);
     void updateSystemInfo(int freeBytes, unsigned long uptimeSeconds);
@@ -342,16 +538,22 @@ class SystemStatus : public GUIElement {
     static int getRequiredHeight() { return 80; }
     
   private:
-    String systemInfo;
-    int freeMemory;
+    int freeMemory;              // -1 until updateMemory() is called
     unsigned long uptime;
-    
+    bool uptimeSet;
+    WebGUIMemoryStats stats;     // Live figures, refreshed at most once per second
+    unsigned long statsTime;
+    bool statsValid;
+    
+    void streamInfo(Print& out);
+    static void streamMemory(Print& out, uint32_t bytes);
+    static void streamUptime(Print& out, unsigned long seconds);
     String formatUptime(unsigned long seconds);
     String formatMemory(int bytes);
 };
 
 // Utility Functions
-int getFreeRAM();   // Cross-platform memory checking function
+int getFreeRAM();   // Cross-platform free heap (see getMemoryStats() for more detail)
 void clearMemory(); // Clear all EEPROM/Preferences memory
 
 // Global instance - can be used directly or create your own
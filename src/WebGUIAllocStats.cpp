@@ -0,0 +1,315 @@
+/*
+  WebGUIAllocStats.cpp - Heap allocation accounting for the WebGUI Library
+
+  Allocations are seen through one of two hooks:
+  - Replacement global operator new/delete (default). Catches containers
+    and anything created with new, but not Arduino String, which calls
+    malloc/realloc directly.
+  - Linker-wrapped malloc/calloc/realloc/free (WEBGUI_ALLOC_STATS_WRAP_MALLOC=1).
+    Catches everything, String included, but needs the linker flags
+    -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+    operator new/delete are still replaced, forwarding to the wrapped
+    malloc/free, so allocations through a shared C++ runtime (the host
+    build) are seen as well.
+
+  The hooks serve both the per-request statistics (WEBGUI_ALLOC_STATS) and
+  the zero-heap assertion (WEBGUI_ZERO_HEAP_ASSERT).
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUIAllocStats.h"
+
+#if WEBGUI_ALLOC_STATS || WEBGUI_ZERO_HEAP_ASSERT
+
+#include <new>
+
+#if defined(ESP32) || defined(WEBGUI_HOST)
+// WiFi and lwIP allocate from their own tasks (the gateway's worker threads
+// on the host build); only watch the task that opened the first scope or
+// guard (the one running loop())
+static TaskHandle_t watchedTask = nullptr;
+
+static inline void watchCurrentTask() {
+    watchedTask = xTaskGetCurrentTaskHandle();
+}
+
+static inline bool isWatchedTask() {
+    return xTaskGetCurrentTaskHandle() == watchedTask;
+}
+#else
+static inline void watchCurrentTask() {
+}
+
+static inline bool isWatchedTask() {
+    return true;
+}
+#endif
+
+#endif
+
+// ============================================================================
+// Per-request statistics
+// ============================================================================
+
+#if WEBGUI_ALLOC_STATS
+
+static WebGUIAllocStats stats[WEBGUI_ALLOC_CATEGORIES];
+
+// Running totals for the calls in progress
+static uint32_t currentAllocations[WEBGUI_ALLOC_CATEGORIES];
+static uint32_t currentBytes[WEBGUI_ALLOC_CATEGORIES];
+static uint32_t currentFrees[WEBGUI_ALLOC_CATEGORIES];
+static uint8_t activeCategories = 0;
+
+static void countAllocation(size_t size) {
+    for (int i = 0; i < WEBGUI_ALLOC_CATEGORIES; i++) {
+        if (activeCategories & (1 << i)) {
+            currentAllocations[i]++;
+            currentBytes[i] += size;
+        }
+    }
+}
+
+static void countFree() {
+    for (int i = 0; i < WEBGUI_ALLOC_CATEGORIES; i++) {
+        if (activeCategories & (1 << i)) {
+            currentFrees[i]++;
+        }
+    }
+}
+
+WebGUIAllocScope::WebGUIAllocScope(WebGUIAllocCategory category)
+    : category(category), active(!(activeCategories & (1 << category))) {
+    if (!active) {
+        return;  // Already counting this category further up the call stack
+    }
+    if (!activeCategories) {
+        watchCurrentTask();
+    }
+    currentAllocations[category] = 0;
+    currentBytes[category] = 0;
+    currentFrees[category] = 0;
+    activeCategories |= (1 << category);
+}
+
+WebGUIAllocScope::~WebGUIAllocScope() {
+    if (!active) {
+        return;
+    }
+    activeCategories &= ~(1 << category);
+    
+    WebGUIAllocStats& s = stats[category];
+    s.calls++;
+    s.allocations += currentAllocations[category];
+    s.bytes += currentBytes[category];
+    s.frees += currentFrees[category];
+    s.lastAllocations = currentAllocations[category];
+    s.lastBytes = currentBytes[category];
+    if (currentAllocations[category] > s.maxAllocations) {
+        s.maxAllocations = currentAllocations[category];
+    }
+    if (currentBytes[category] > s.maxBytes) {
+        s.maxBytes = currentBytes[category];
+    }
+}
+
+WebGUIAllocStats getAllocStats(WebGUIAllocCategory category) {
+    return stats[category];
+}
+
+void resetAllocStats() {
+    memset(stats, 0, sizeof(stats));
+}
+
+#else
+
+WebGUIAllocStats getAllocStats(WebGUIAllocCategory) {
+    WebGUIAllocStats empty = {};
+    return empty;
+}
+
+void resetAllocStats() {
+}
+
+#endif
+
+// ============================================================================
+// Zero-heap assertion
+// ============================================================================
+
+#if WEBGUI_ZERO_HEAP_ASSERT
+
+static uint8_t guardDepth = 0;
+static uint8_t exemptDepth = 0;
+static unsigned long heapViolations = 0;
+
+WebGUIHeapGuard::WebGUIHeapGuard() {
+    if (guardDepth++ == 0) {
+        watchCurrentTask();
+    }
+}
+
+WebGUIHeapGuard::~WebGUIHeapGuard() {
+    guardDepth--;
+}
+
+WebGUIHeapExempt::WebGUIHeapExempt() {
+    exemptDepth++;
+}
+
+WebGUIHeapExempt::~WebGUIHeapExempt() {
+    exemptDepth--;
+}
+
+extern "C" __attribute__((weak)) void webguiOnHeapViolation(size_t size) {
+    Serial.print("WebGUI: heap allocation of ");
+    Serial.print((unsigned long)size);
+    Serial.println(" bytes inside update() with WEBGUI_ZERO_HEAP");
+    Serial.flush();
+    abort();
+}
+
+static void checkAllocation(size_t size) {
+    if (guardDepth && !exemptDepth && isWatchedTask()) {
+        heapViolations++;
+        exemptDepth++;  // Whatever the handler does is not a new violation
+        webguiOnHeapViolation(size);
+        exemptDepth--;
+    }
+}
+
+unsigned long getHeapViolations() {
+    return heapViolations;
+}
+
+#else
+
+unsigned long getHeapViolations() {
+    return 0;
+}
+
+#endif
+
+// ============================================================================
+// Allocation hooks
+// ============================================================================
+
+#if WEBGUI_ALLOC_STATS || WEBGUI_ZERO_HEAP_ASSERT
+
+static void recordAllocation(size_t size) {
+#if WEBGUI_ZERO_HEAP_ASSERT
+    checkAllocation(size);
+#endif
+#if WEBGUI_ALLOC_STATS
+    if (activeCategories && isWatchedTask()) {
+        countAllocation(size);
+    }
+#endif
+}
+
+static void recordFree(void* ptr) {
+#if WEBGUI_ALLOC_STATS
+    if (ptr && activeCategories && isWatchedTask()) {
+        countFree();
+    }
+#else
+    (void)ptr;
+#endif
+}
+
+#if WEBGUI_ALLOC_STATS_WRAP_MALLOC
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+    recordAllocation(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    recordAllocation(count * size);
+    return __real_calloc(count, size);
+}
+
+// A growing String is a realloc; count it as the allocation it may be
+void* __wrap_realloc(void* ptr, size_t size) {
+    if (size == 0) {
+        recordFree(ptr);
+    } else {
+        recordAllocation(size);
+    }
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    recordFree(ptr);
+    __real_free(ptr);
+}
+}
+
+#endif
+
+// With malloc wrapped, new and delete are counted by the malloc and free
+// they call
+static inline void recordNew(size_t size) {
+#if WEBGUI_ALLOC_STATS_WRAP_MALLOC
+    (void)size;
+#else
+    recordAllocation(size);
+#endif
+}
+
+static inline void recordDelete(void* ptr) {
+#if WEBGUI_ALLOC_STATS_WRAP_MALLOC
+    (void)ptr;
+#else
+    recordFree(ptr);
+#endif
+}
+
+void* operator new(size_t size) {
+    recordNew(size);
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size) {
+    recordNew(size);
+    return malloc(size ? size : 1);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    recordNew(size);
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    recordNew(size);
+    return malloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept {
+    recordDelete(ptr);
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    recordDelete(ptr);
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    recordDelete(ptr);
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    recordDelete(ptr);
+    free(ptr);
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+  WebGUIAllocStats.h - Heap allocation accounting for the WebGUI Library
+
+  Build with WEBGUI_ALLOC_STATS=1 to count the heap allocations made while
+  serving each kind of request (page, /get, /set) and during each update()
+  call. Intended for development and host test builds: it shows at a glance
+  whether a change made the steady-state /get path start allocating again.
+
+  With WEBGUI_ALLOC_STATS=0 (default) the scopes compile away and
+  getAllocStats() reports zeros.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIAllocStats_h
+#define WebGUIAllocStats_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+enum WebGUIAllocCategory {
+    WEBGUI_ALLOC_PAGE,     // Full page requests
+    WEBGUI_ALLOC_GET,      // /get polling requests
+    WEBGUI_ALLOC_SET,      // /set update requests
+    WEBGUI_ALLOC_UPDATE,   // Whole GUI.update() calls, including any request served
+    WEBGUI_ALLOC_CATEGORIES
+};
+
+struct WebGUIAllocStats {
+    uint32_t calls;             // Requests served / update() calls counted
+    uint32_t allocations;       // Allocations across all of those calls
+    uint32_t bytes;             // Bytes requested across all of those calls
+    uint32_t frees;
+    uint32_t lastAllocations;   // Most recent call only
+    uint32_t lastBytes;
+    uint32_t maxAllocations;    // Worst single call
+    uint32_t maxBytes;
+};
+
+WebGUIAllocStats getAllocStats(WebGUIAllocCategory category);
+void resetAllocStats();
+
+#if WEBGUI_ALLOC_STATS
+
+// Counts every allocation made between construction and destruction
+// towards one category. Scopes of different categories may nest.
+class WebGUIAllocScope {
+  public:
+    explicit WebGUIAllocScope(WebGUIAllocCategory category);
+    ~WebGUIAllocScope();
+    
+  private:
+    WebGUIAllocCategory category;
+    bool active;
+};
+
+#else
+
+class WebGUIAllocScope {
+  public:
+    explicit WebGUIAllocScope(WebGUIAllocCategory) {}
+};
+
+#endif
+
+// ============================================================================
+// Zero-heap assertion
+// ============================================================================
+
+// Allocations made while a guard is open call webguiOnHeapViolation().
+// Calls into the WiFi core are wrapped in WebGUIHeapExempt: the guarantee
+// covers library code, not the network stack underneath it.
+unsigned long getHeapViolations();
+
+#if WEBGUI_ZERO_HEAP_ASSERT
+
+class WebGUIHeapGuard {
+  public:
+    WebGUIHeapGuard();
+    ~WebGUIHeapGuard();
+};
+
+class WebGUIHeapExempt {
+  public:
+    WebGUIHeapExempt();
+    ~WebGUIHeapExempt();
+};
+
+// Weak; the default prints the size of the allocation and halts. Define
+// your own to log and continue instead (it must not allocate).
+extern "C" void webguiOnHeapViolation(size_t size);
+
+#else
+
+class WebGUIHeapGuard {
+  public:
+    WebGUIHeapGuard() {}
+};
+
+class WebGUIHeapExempt {
+  public:
+    WebGUIHeapExempt() {}
+};
+
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+/*
+  WebGUIArena.h - Per-request scratch memory for the WebGUI Library
+
+  A bump-pointer arena over a fixed buffer. Everything a request needs for
+  its lifetime (request line, decoded parameters, output buffer) is carved
+  out of it, and the whole arena is reset once the response has been sent.
+  Request handling therefore never calls malloc/free, and the most memory a
+  request can use is WEBGUI_REQUEST_ARENA_SIZE.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIArena_h
+#define WebGUIArena_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+class WebGUIArena {
+  public:
+    WebGUIArena() : used(0), peak(0), failures(0) {}
+
+    // Returns nullptr (and counts a failure) when the arena is exhausted
+    void* allocate(size_t size) {
+        size_t start = (used + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        if (start > sizeof(storage) || size > sizeof(storage) - start) {
+            failures++;
+            return nullptr;
+        }
+        used = start + size;
+        if (used > peak) peak = used;
+        return storage + start;
+    }
+
+    char* allocateChars(size_t count) { return static_cast<char*>(allocate(count)); }
+
+    // Largest block allocate() can still return
+    size_t remaining() const {
+        size_t start = (used + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        return start < sizeof(storage) ? sizeof(storage) - start : 0;
+    }
+
+    void reset() { used = 0; }
+
+    size_t getUsed() const { return used; }
+    size_t getPeak() const { return peak; }
+    size_t getCapacity() const { return sizeof(storage); }
+    unsigned long getFailures() const { return failures; }
+
+  private:
+    static const size_t ALIGNMENT = sizeof(void*);
+
+    alignas(sizeof(void*)) uint8_t storage[WEBGUI_REQUEST_ARENA_SIZE];
+    size_t used;
+    size_t peak;
+    unsigned long failures;
+};
+
+#endif
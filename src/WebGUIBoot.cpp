@@ -0,0 +1,49 @@
+/*
+  WebGUIBoot.cpp - Startup timeline for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUIBoot.h"
+#include "WebGUIFormat.h"
+
+const char* webguiBootPhaseName(int phase) {
+    static const char* const NAMES[WEBGUI_BOOT_PHASES] = {
+        "radio", "associate", "dhcp", "static_ip", "settings", "server"
+    };
+    return phase >= 0 && phase < WEBGUI_BOOT_PHASES ? NAMES[phase] : "unknown";
+}
+
+#if WEBGUI_BOOT_TIMELINE_SIZE > 0
+
+void WebGUIBootTimeline::dump(Print& out) const {
+    out.print("# now_ms ");
+    out.println(millis());
+    out.println("# phase     start_ms duration_ms  result");
+    for (size_t i = 0; i < count; i++) {
+        const WebGUIBootEntry& e = entries[i];
+        webguiPrintLeft(out, webguiBootPhaseName(e.phase), 10);
+        webguiPrintRight(out, e.startMillis, 10);
+        webguiPrintRight(out, e.durationMillis, 12);
+        out.println(e.ok ? "  ok" : "  failed");
+    }
+    if (overflow) {
+        out.print("# ");
+        out.print(overflow);
+        out.println(" more phase(s) not recorded, raise WEBGUI_BOOT_TIMELINE_SIZE");
+    }
+
+    out.print("# settings reads before ready: ");
+    out.print(settingsReads);
+    out.print(" in ");
+    out.print(settingsReadMicros);
+    out.println(" us");
+    if (ready) {
+        out.print("# ready_ms ");
+        out.println(readyMillis);
+    } else {
+        out.println("# ready_ms none (no page served yet)");
+    }
+}
+
+#endif
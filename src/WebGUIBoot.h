@@ -0,0 +1,131 @@
+/*
+  WebGUIBoot.h - Startup timeline for the WebGUI Library
+
+  Records when each startup phase began and how long it took: bringing the
+  radio up, associating with the access point, getting a DHCP lease,
+  applying a static IP, opening settings storage and starting the server.
+  It also records when the first page was served. Together they show where
+  the seconds between power-on and a usable page go. The report is served
+  at /debug/boot and printed by GUI.dumpBootReport().
+
+  Times are millis() since boot, so whatever the sketch does before and
+  between the WebGUI calls shows up as gaps between phases.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIBoot_h
+#define WebGUIBoot_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+enum WebGUIBootPhase {
+    WEBGUI_BOOT_RADIO,       // WiFi.begin(), beginAP() or softAP() call
+    WEBGUI_BOOT_ASSOCIATE,   // Waiting for WL_CONNECTED
+    WEBGUI_BOOT_DHCP,        // Connected, waiting for an address
+    WEBGUI_BOOT_STATIC_IP,   // Disconnecting and applying a static address
+    WEBGUI_BOOT_SETTINGS,    // Opening settings storage
+    WEBGUI_BOOT_SERVER,      // begin()
+    WEBGUI_BOOT_PHASES
+};
+
+// "radio", "associate", ... as printed in the boot report
+const char* webguiBootPhaseName(int phase);
+
+struct WebGUIBootEntry {
+    uint32_t startMillis;
+    uint32_t durationMillis;
+    uint8_t phase;           // WebGUIBootPhase
+    bool ok;
+};
+
+#if WEBGUI_BOOT_TIMELINE_SIZE > 0
+
+class WebGUIBootTimeline {
+  public:
+    WebGUIBootTimeline()
+        : count(0), overflow(0), readyMillis(0), ready(false), settingsReads(0), settingsReadMicros(0) {}
+
+    // A phase that began at startMillis and ends now. Phases after the
+    // timeline is full are only counted.
+    void record(WebGUIBootPhase phase, uint32_t startMillis, bool ok = true) {
+        if (count == WEBGUI_BOOT_TIMELINE_SIZE) {
+            overflow++;
+            return;
+        }
+        WebGUIBootEntry& entry = entries[count++];
+        entry.startMillis = startMillis;
+        entry.durationMillis = millis() - startMillis;
+        entry.phase = phase;
+        entry.ok = ok;
+    }
+
+    // The first page has been served; later calls change nothing
+    void markReady() {
+        if (!ready) {
+            ready = true;
+            readyMillis = millis();
+        }
+    }
+
+    bool isReady() const { return ready; }
+    uint32_t getReadyMillis() const { return readyMillis; }
+
+    // load*Setting() calls before the first page, totalled rather than
+    // recorded one by one
+    void addSettingsRead(uint32_t micros) {
+        if (!ready) {
+            settingsReads++;
+            settingsReadMicros += micros;
+        }
+    }
+
+    size_t size() const { return count; }
+    const WebGUIBootEntry& get(size_t index) const { return entries[index]; }
+
+    // One line per phase, then the settings reads and the ready time
+    void dump(Print& out) const;
+
+  private:
+    WebGUIBootEntry entries[WEBGUI_BOOT_TIMELINE_SIZE];
+    uint8_t count;
+    uint8_t overflow;
+    uint32_t readyMillis;
+    bool ready;
+    uint16_t settingsReads;
+    uint32_t settingsReadMicros;
+};
+
+// Times one settings read into the timeline, however the function returns
+class WebGUIBootSettingsRead {
+  public:
+    explicit WebGUIBootSettingsRead(WebGUIBootTimeline& boot) : boot(boot), start(micros()) {}
+    ~WebGUIBootSettingsRead() { boot.addSettingsRead(micros() - start); }
+
+  private:
+    WebGUIBootTimeline& boot;
+    unsigned long start;
+};
+
+#else
+
+class WebGUIBootTimeline {
+  public:
+    void record(WebGUIBootPhase, uint32_t, bool = true) {}
+    void markReady() {}
+    bool isReady() const { return true; }
+    uint32_t getReadyMillis() const { return 0; }
+    void addSettingsRead(uint32_t) {}
+    size_t size() const { return 0; }
+    void dump(Print&) const {}
+};
+
+class WebGUIBootSettingsRead {
+  public:
+    explicit WebGUIBootSettingsRead(WebGUIBootTimeline&) {}
+};
+
+#endif
+
+#endif
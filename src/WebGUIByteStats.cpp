@@ -0,0 +1,12 @@
+/*
+  WebGUIByteStats.cpp - Response byte accounting for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUIByteStats.h"
+
+const char* webguiBytesPartName(int part) {
+    static const char* const NAMES[WEBGUI_BYTES_PARTS] = { "html", "js", "value", "css", "script", "framing" };
+    return part >= 0 && part < WEBGUI_BYTES_PARTS ? NAMES[part] : "none";
+}
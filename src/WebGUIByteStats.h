@@ -0,0 +1,103 @@
+/*
+  WebGUIByteStats.h - Response byte accounting for the WebGUI Library
+
+  Attributes the bytes of each page and /get response to the part that
+  produced them: the shared CSS and JavaScript, the page skeleton, and each
+  element's markup, script and value. Totals per route are in
+  WebGUIMetrics; these say what inside a route the bytes were spent on.
+
+  Counting wraps the response in a WebGUIByteTap, which adds one forwarding
+  call per write. With WEBGUI_BYTE_STATS=0 (default) the tap is the
+  response itself and nothing is counted.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIByteStats_h
+#define WebGUIByteStats_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+enum WebGUIBytesPart {
+    WEBGUI_BYTES_HTML,      // Element markup in the page
+    WEBGUI_BYTES_JS,        // Element event handlers in the page
+    WEBGUI_BYTES_VALUE,     // Element entries in /get responses
+    WEBGUI_ELEMENT_BYTES_PARTS,
+    WEBGUI_BYTES_CSS = WEBGUI_ELEMENT_BYTES_PARTS,   // Theme and custom CSS
+    WEBGUI_BYTES_SCRIPT,    // JavaScript shared by all elements
+    WEBGUI_BYTES_FRAMING,   // Page skeleton, title, heading, /get braces
+    WEBGUI_BYTES_PARTS
+};
+
+// "html", "js", ... as used in /metrics labels
+const char* webguiBytesPartName(int part);
+
+#if WEBGUI_BYTE_STATS
+
+// Forwards to another Print, counting what passes through
+class WebGUIByteTap : public Print {
+  public:
+    explicit WebGUIByteTap(Print& target) : target(target), count(0) {}
+
+    size_t write(uint8_t c) override {
+        size_t n = target.write(c);
+        count += n;
+        return n;
+    }
+    size_t write(const uint8_t* data, size_t size) override {
+        size_t n = target.write(data, size);
+        count += n;
+        return n;
+    }
+    using Print::write;
+    void flush() override { target.flush(); }
+
+    Print& out() { return *this; }
+
+    // Bytes written since the last call
+    uint32_t take() {
+        uint32_t n = count;
+        count = 0;
+        return n;
+    }
+
+  private:
+    Print& target;
+    uint32_t count;
+};
+
+class WebGUIByteStats {
+  public:
+    WebGUIByteStats() { reset(); }
+
+    void add(WebGUIBytesPart part, uint32_t bytes) { totals[part] += bytes; }
+    uint32_t get(WebGUIBytesPart part) const { return totals[part]; }
+    void reset() { memset(totals, 0, sizeof(totals)); }
+
+  private:
+    uint32_t totals[WEBGUI_BYTES_PARTS];
+};
+
+#else
+
+class WebGUIByteTap {
+  public:
+    explicit WebGUIByteTap(Print& target) : target(target) {}
+    Print& out() { return target; }
+    uint32_t take() { return 0; }
+
+  private:
+    Print& target;
+};
+
+class WebGUIByteStats {
+  public:
+    void add(WebGUIBytesPart, uint32_t) {}
+    uint32_t get(WebGUIBytesPart) const { return 0; }
+    void reset() {}
+};
+
+#endif
+
+#endif
@@ -0,0 +1,136 @@
+/*
+  WebGUICapture.cpp - Raw request recording for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUICapture.h"
+
+#if WEBGUI_CAPTURE_SIZE > 0
+
+void WebGUICapture::clear() {
+    first = 0;
+    used = 0;
+    requests = 0;
+    dropped = 0;
+    truncated = 0;
+    recording = false;
+}
+
+void WebGUICapture::control(const char* command) {
+    if (strncmp(command, "start", 5) == 0) {
+        start();
+    } else if (strncmp(command, "stop", 4) == 0) {
+        stop();
+    } else if (strncmp(command, "clear", 5) == 0) {
+        clear();
+    }
+}
+
+// Drops the oldest complete requests until there is room; false if even
+// an empty ring (bar the request being recorded) has none
+bool WebGUICapture::makeRoom(size_t bytes) {
+    while (WEBGUI_CAPTURE_SIZE - used < bytes) {
+        if (requests == 0) {
+            return false;
+        }
+        size_t size = HEADER_SIZE + (lengthAt(0) & ~TRUNCATED_FLAG);
+        first = (first + size) % WEBGUI_CAPTURE_SIZE;
+        used -= size;
+        requests--;
+        dropped++;
+    }
+    return true;
+}
+
+void WebGUICapture::begin() {
+    cancel();
+    if (!running || !makeRoom(HEADER_SIZE)) {
+        return;
+    }
+    recordStart = (first + used) % WEBGUI_CAPTURE_SIZE;
+    uint32_t offset = millis() - startMillis;
+    for (size_t i = 0; i < 4; i++) {
+        put(recordStart + i, (uint8_t)(offset >> (8 * i)));
+    }
+    used += HEADER_SIZE;
+    recordLength = 0;
+    recordTruncated = false;
+    recording = true;
+}
+
+void WebGUICapture::add(uint8_t c) {
+    if (!recording || recordTruncated) {
+        return;
+    }
+    if (recordLength == (uint16_t)~TRUNCATED_FLAG || !makeRoom(1)) {
+        recordTruncated = true;
+        return;
+    }
+    put(recordStart + HEADER_SIZE + recordLength, c);
+    recordLength++;
+    used++;
+}
+
+void WebGUICapture::commit() {
+    if (!recording) {
+        return;
+    }
+    recording = false;
+    if (recordLength == 0 && !recordTruncated) {
+        used -= HEADER_SIZE;  // Closed without sending anything
+        return;
+    }
+    uint16_t length = recordLength | (recordTruncated ? TRUNCATED_FLAG : 0);
+    put(recordStart + 4, (uint8_t)length);
+    put(recordStart + 5, (uint8_t)(length >> 8));
+    requests++;
+    if (recordTruncated) {
+        truncated++;
+    }
+}
+
+void WebGUICapture::cancel() {
+    if (recording) {
+        used -= HEADER_SIZE + recordLength;
+        recording = false;
+    }
+}
+
+void WebGUICapture::dump(Print& out) const {
+    out.print("# webgui-capture 1\n# started_ms ");
+    out.print(startMillis);
+    out.print(running ? " running yes\n" : " running no\n");
+    out.print("# requests ");
+    out.print((unsigned int)requests);
+    out.print(" dropped ");
+    out.print(dropped);
+    out.print(" truncated ");
+    out.print(truncated);
+    out.print('\n');
+
+    size_t offset = 0;
+    for (uint16_t i = 0; i < requests; i++) {
+        uint32_t millisOffset = 0;
+        for (size_t b = 0; b < 4; b++) {
+            millisOffset |= (uint32_t)at(offset + b) << (8 * b);
+        }
+        uint16_t length = lengthAt(offset);
+        size_t bytes = length & ~TRUNCATED_FLAG;
+        out.print('@');
+        out.print(millisOffset);
+        out.print(' ');
+        out.print((unsigned int)bytes);
+        out.print(length & TRUNCATED_FLAG ? " truncated\n" : "\n");
+
+        // The request's bytes may wrap around the end of the ring
+        size_t position = (first + offset + HEADER_SIZE) % WEBGUI_CAPTURE_SIZE;
+        size_t contiguous = bytes < WEBGUI_CAPTURE_SIZE - position ? bytes : WEBGUI_CAPTURE_SIZE - position;
+        out.write(buffer + position, contiguous);
+        out.write(buffer, bytes - contiguous);
+        out.print('\n');
+        offset += HEADER_SIZE + bytes;
+    }
+}
+
+#endif
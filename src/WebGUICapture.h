@@ -0,0 +1,125 @@
+/*
+  WebGUICapture.h - Raw request recording for the WebGUI Library
+
+  Records the bytes of each incoming request exactly as they arrived,
+  with the time the connection was accepted, so a session from a real
+  device can be replayed against another version of the library on the
+  host build (extras/host, replay_<personality>) and its latency and
+  heap use compared on identical traffic.
+
+  Requests are kept in a ring of WEBGUI_CAPTURE_SIZE bytes; when it is
+  full the oldest requests are dropped. The capture is served at
+  /debug/capture (?start, ?stop and ?clear control it first) and printed
+  by GUI.dumpCapture() in this format:
+
+    # webgui-capture 1
+    # started_ms 51200 running yes
+    # requests 3 dropped 0 truncated 0
+    @0 412
+    <412 raw request bytes>
+    @95 409
+    ...
+
+  Each request is "@<ms since start> <bytes>", a newline, exactly that
+  many bytes and a newline; a request that didn't fit is marked
+  "truncated" after its length. Requests carry whatever the browser sent,
+  cookies included, so the route only exists when WEBGUI_CAPTURE_SIZE is
+  set.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUICapture_h
+#define WebGUICapture_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+#if WEBGUI_CAPTURE_SIZE > 0
+
+class WebGUICapture {
+  public:
+    WebGUICapture()
+        : first(0), used(0), requests(0), dropped(0), truncated(0), startMillis(0),
+          recordStart(0), recordLength(0), running(false), recording(false), recordTruncated(false) {}
+
+    // start() empties the capture and records from now; stop() keeps what
+    // was recorded. A request already arriving is still completed.
+    void start() {
+        clear();
+        startMillis = millis();
+        running = true;
+    }
+    void stop() { running = false; }
+    void clear();
+    bool isRunning() const { return running; }
+
+    // "start", "stop" or "clear" (as in /debug/capture?stop); anything
+    // else changes nothing
+    void control(const char* command);
+
+    // A connection was accepted: its bytes follow through add(), then
+    // commit() keeps the request or cancel() leaves it out. Nothing is
+    // recorded while stopped.
+    void begin();
+    void add(uint8_t c);
+    void add(const char* text) {
+        while (*text) {
+            add((uint8_t)*text++);
+        }
+    }
+    void commit();
+    void cancel();
+
+    size_t size() const { return requests; }
+    uint32_t getDropped() const { return dropped; }     // Overwritten by newer requests
+    uint32_t getTruncated() const { return truncated; } // Longer than the ring could hold
+    size_t getBytesUsed() const { return used; }
+
+    void dump(Print& out) const;
+
+  private:
+    static const size_t HEADER_SIZE = 6;           // uint32 ms since start, uint16 length
+    static const uint16_t TRUNCATED_FLAG = 0x8000;  // In the length
+
+    uint8_t at(size_t offset) const { return buffer[(first + offset) % WEBGUI_CAPTURE_SIZE]; }
+    void put(size_t position, uint8_t c) { buffer[position % WEBGUI_CAPTURE_SIZE] = c; }
+    uint16_t lengthAt(size_t offset) const { return at(offset + 4) | (at(offset + 5) << 8); }
+    bool makeRoom(size_t bytes);
+
+    uint8_t buffer[WEBGUI_CAPTURE_SIZE];
+    size_t first;          // Position of the oldest complete request
+    size_t used;           // Bytes held, including the request being recorded
+    uint16_t requests;     // Complete requests held
+    uint32_t dropped;
+    uint32_t truncated;
+    uint32_t startMillis;
+
+    size_t recordStart;    // Request being recorded: header position
+    uint16_t recordLength; // and bytes so far
+    bool running;
+    bool recording;
+    bool recordTruncated;
+};
+
+#else
+
+class WebGUICapture {
+  public:
+    void start() {}
+    void stop() {}
+    void clear() {}
+    bool isRunning() const { return false; }
+    void control(const char*) {}
+    void begin() {}
+    void add(uint8_t) {}
+    void add(const char*) {}
+    void commit() {}
+    void cancel() {}
+    size_t size() const { return 0; }
+    void dump(Print&) const {}
+};
+
+#endif
+
+#endif
@@ -0,0 +1,315 @@
+/*
+  WebGUIConfig.h - Compile-time configuration for the WebGUI Library
+
+  Every option can be overridden from the build flags (for example
+  -DWEBGUI_INLINE_STRINGS=1 in PlatformIO's build_flags) or by editing the
+  defaults below.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIConfig_h
+#define WebGUIConfig_h
+
+// ============================================================================
+// Zero-heap mode
+// ============================================================================
+
+// 1: once begin() returns, update() and request handling never allocate.
+//    Turns on inline strings and a fixed element array, and makes ESP32
+//    serve through WiFiServer instead of the WebServer library (which
+//    allocates Strings for every request).
+#ifndef WEBGUI_ZERO_HEAP
+  #define WEBGUI_ZERO_HEAP 0
+#endif
+
+// ============================================================================
+// Element string storage
+// ============================================================================
+
+// 0: element labels and values are heap Strings (default, unlimited length)
+// 1: element labels and values live in fixed-capacity inline buffers inside
+//    each element, so updating them never touches the heap
+#ifndef WEBGUI_INLINE_STRINGS
+  #define WEBGUI_INLINE_STRINGS WEBGUI_ZERO_HEAP
+#endif
+
+// Inline capacities in characters (excluding the terminator)
+#ifndef WEBGUI_ID_CAPACITY
+  #define WEBGUI_ID_CAPACITY 11           // "element" + up to 4 digits
+#endif
+#ifndef WEBGUI_LABEL_CAPACITY
+  #define WEBGUI_LABEL_CAPACITY 31
+#endif
+#ifndef WEBGUI_SENSOR_VALUE_CAPACITY
+  #define WEBGUI_SENSOR_VALUE_CAPACITY 31
+#endif
+#ifndef WEBGUI_TEXTBOX_CAPACITY
+  #define WEBGUI_TEXTBOX_CAPACITY 47
+#endif
+#ifndef WEBGUI_PLACEHOLDER_CAPACITY
+  #define WEBGUI_PLACEHOLDER_CAPACITY 31
+#endif
+#ifndef WEBGUI_BUTTON_STYLE_CAPACITY
+  #define WEBGUI_BUTTON_STYLE_CAPACITY 11   // "secondary" is the longest built-in style
+#endif
+
+// What happens when a value does not fit (see WebGUITruncation in WebGUIString.h)
+#ifndef WEBGUI_LABEL_TRUNCATION
+  #define WEBGUI_LABEL_TRUNCATION WEBGUI_TRUNCATE_ELLIPSIS
+#endif
+#ifndef WEBGUI_SENSOR_VALUE_TRUNCATION
+  #define WEBGUI_SENSOR_VALUE_TRUNCATION WEBGUI_TRUNCATE_ELLIPSIS
+#endif
+#ifndef WEBGUI_TEXTBOX_TRUNCATION
+  #define WEBGUI_TEXTBOX_TRUNCATION WEBGUI_KEEP_PREVIOUS
+#endif
+
+// ============================================================================
+// Request memory
+// ============================================================================
+
+// Scratch memory for one request, reset after each response (WebGUIArena.h).
+// It covers the WiFiServer path (UNO R4 WiFi, Nano 33 IoT, ESP32 with
+// WEBGUI_ZERO_HEAP). The ESP32 WebServer library parses each request into
+// Strings itself and hands arguments back as String copies, so there only
+// the response buffer comes from the arena.
+#ifndef WEBGUI_REQUEST_ARENA_SIZE
+  #define WEBGUI_REQUEST_ARENA_SIZE 1024
+#endif
+
+// Longest request line accepted; longer requests get 414 URI Too Long
+#ifndef WEBGUI_MAX_REQUEST_LINE
+  #define WEBGUI_MAX_REQUEST_LINE 512
+#endif
+
+// A client that stops sending for this long before its request is complete
+// is disconnected, so a stalled connection can't hold update() indefinitely
+#ifndef WEBGUI_REQUEST_TIMEOUT_MS
+  #define WEBGUI_REQUEST_TIMEOUT_MS 5000
+#endif
+
+// Output is batched into writes of this size (WebGUIResponse.h)
+#ifndef WEBGUI_RESPONSE_BUFFER_SIZE
+  #define WEBGUI_RESPONSE_BUFFER_SIZE 256
+#endif
+
+// Every request holds its request line and the response buffer in the
+// arena at once (the line rounded up to the arena's 8-byte alignment)
+#if (WEBGUI_MAX_REQUEST_LINE + 7) / 8 * 8 + WEBGUI_RESPONSE_BUFFER_SIZE > WEBGUI_REQUEST_ARENA_SIZE
+  #error "WEBGUI_REQUEST_ARENA_SIZE must hold WEBGUI_MAX_REQUEST_LINE plus WEBGUI_RESPONSE_BUFFER_SIZE"
+#endif
+
+// ============================================================================
+// Element storage
+// ============================================================================
+
+// 0: elements are kept in a std::vector that grows as they are added
+// N: room for exactly N elements is reserved inside the WebGUI object
+//    (std::array), so memory use is fixed at link time (WebGUIElementList.h)
+#ifndef WEBGUI_MAX_ELEMENTS
+  #if WEBGUI_ZERO_HEAP
+    #define WEBGUI_MAX_ELEMENTS 16
+  #else
+    #define WEBGUI_MAX_ELEMENTS 0
+  #endif
+#endif
+
+#if WEBGUI_ZERO_HEAP && (!WEBGUI_INLINE_STRINGS || WEBGUI_MAX_ELEMENTS == 0)
+  #error "WEBGUI_ZERO_HEAP needs WEBGUI_INLINE_STRINGS=1 and WEBGUI_MAX_ELEMENTS > 0"
+#endif
+
+// ============================================================================
+// Allocation accounting
+// ============================================================================
+
+// 1: count heap allocations per request type and per update() call,
+//    readable with getAllocStats() (WebGUIAllocStats.h). Development aid.
+#ifndef WEBGUI_ALLOC_STATS
+  #define WEBGUI_ALLOC_STATS 0
+#endif
+
+// How allocations are seen, here and by WEBGUI_ZERO_HEAP_ASSERT:
+// 0: through replacement operator new/delete (String is not seen)
+// 1: through malloc/calloc/realloc/free; link with
+//    -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+#ifndef WEBGUI_ALLOC_STATS_WRAP_MALLOC
+  #define WEBGUI_ALLOC_STATS_WRAP_MALLOC 0
+#endif
+
+// 1: trap any heap allocation library code makes inside update()
+//    (see webguiOnHeapViolation() in WebGUIAllocStats.h). Development aid;
+//    set to 0 for production builds. On by default in zero-heap mode.
+//    Without WEBGUI_ALLOC_STATS_WRAP_MALLOC it only sees operator new, so
+//    String allocations are not trapped.
+#ifndef WEBGUI_ZERO_HEAP_ASSERT
+  #define WEBGUI_ZERO_HEAP_ASSERT WEBGUI_ZERO_HEAP
+#endif
+
+// ============================================================================
+// Load shedding
+// ============================================================================
+
+// 1: read heap and stack figures through the ESP-style API
+//    (ESP.getFreeHeap(), getMinFreeHeap(), getMaxAllocHeap() and
+//    uxTaskGetStackHighWaterMark()) instead of newlib's sbrk()/mallinfo()
+//    and a painted stack. On for ESP32; a core that offers the same API
+//    elsewhere can turn it on.
+#ifndef WEBGUI_ESP_HEAP_API
+  #if defined(ESP32)
+    #define WEBGUI_ESP_HEAP_API 1
+  #else
+    #define WEBGUI_ESP_HEAP_API 0
+  #endif
+#endif
+
+// Free heap (bytes) below which page requests get 503 Service Unavailable.
+// /get and /set are still served; they stream and need no heap. 0 disables.
+#ifndef WEBGUI_SHED_PAGES_BELOW
+  #if defined(ESP32)
+    #define WEBGUI_SHED_PAGES_BELOW 8192
+  #else
+    #define WEBGUI_SHED_PAGES_BELOW 1024
+  #endif
+#endif
+
+// Free heap below which no new connections are served at all. 0 disables.
+#ifndef WEBGUI_REFUSE_CONNECTIONS_BELOW
+  #if defined(ESP32)
+    #define WEBGUI_REFUSE_CONNECTIONS_BELOW 4096
+  #else
+    #define WEBGUI_REFUSE_CONNECTIONS_BELOW 512
+  #endif
+#endif
+
+// Normal service resumes once free heap is this far above a threshold,
+// so a heap hovering around it doesn't flip the state every request
+#ifndef WEBGUI_SHED_HYSTERESIS
+  #define WEBGUI_SHED_HYSTERESIS 512
+#endif
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+// 1: count requests, bytes and latencies per route and time every update()
+//    call; served in Prometheus text format at /metrics (WebGUIMetrics.h).
+//    The counters take about 1.2 KB, so they are off by default on the
+//    32 KB boards.
+#ifndef WEBGUI_METRICS
+  #if defined(ESP32)
+    #define WEBGUI_METRICS 1
+  #else
+    #define WEBGUI_METRICS 0
+  #endif
+#endif
+
+// ============================================================================
+// Request Trace
+// ============================================================================
+
+// Requests remembered for /debug/trace and GUI.dumpTrace() (WebGUITrace.h),
+// about 32 bytes each; 0 removes the trace
+#ifndef WEBGUI_TRACE_SIZE
+  #if defined(ESP32)
+    #define WEBGUI_TRACE_SIZE 32
+  #else
+    #define WEBGUI_TRACE_SIZE 4
+  #endif
+#endif
+
+// ============================================================================
+// Logging
+// ============================================================================
+
+#define WEBGUI_LOG_LEVEL_NONE  0
+#define WEBGUI_LOG_LEVEL_ERROR 1
+#define WEBGUI_LOG_LEVEL_WARN  2
+#define WEBGUI_LOG_LEVEL_INFO  3
+#define WEBGUI_LOG_LEVEL_DEBUG 4
+
+// Most verbose library messages compiled in (WebGUILog.h). Messages above
+// this level are removed at compile time, arguments and all.
+// INFO: startup and network messages; DEBUG adds per-request diagnostics
+#ifndef WEBGUI_LOG_LEVEL
+  #define WEBGUI_LOG_LEVEL WEBGUI_LOG_LEVEL_INFO
+#endif
+
+// Print object library messages are written to
+#ifndef WEBGUI_LOG_OUTPUT
+  #define WEBGUI_LOG_OUTPUT Serial
+#endif
+
+// Bytes of recent log text kept in RAM (webguiLog in WebGUILog.h). Messages
+// logged while update() serves a request wait here and are written to
+// WEBGUI_LOG_OUTPUT by idle update() calls, so a slow UART never holds up a
+// response; the same text is served at /debug/log. 0 writes directly.
+#ifndef WEBGUI_LOG_BUFFER_SIZE
+  #if WEBGUI_LOG_LEVEL == WEBGUI_LOG_LEVEL_NONE
+    #define WEBGUI_LOG_BUFFER_SIZE 0
+  #elif defined(ESP32)
+    #define WEBGUI_LOG_BUFFER_SIZE 2048
+  #else
+    #define WEBGUI_LOG_BUFFER_SIZE 256
+  #endif
+#endif
+
+// Bytes an idle update() writes when the output can't say how much room it
+// has. availableForWrite() returns 0 both for a full UART and for a Print
+// that doesn't implement it (and some USB serial ports), so 0 is taken as
+// "unknown" and the log still drains, one small write at a time.
+#ifndef WEBGUI_LOG_DRAIN_CHUNK
+  #define WEBGUI_LOG_DRAIN_CHUNK 64
+#endif
+
+// ============================================================================
+// Byte Accounting
+// ============================================================================
+
+// 1: attribute page and /get response bytes to CSS, shared JavaScript and
+//    each element's markup, script and value (WebGUIByteStats.h); reported
+//    by GUI.dumpByteStats() and at /metrics. Costs one extra call per write.
+#ifndef WEBGUI_BYTE_STATS
+  #define WEBGUI_BYTE_STATS 0
+#endif
+
+// ============================================================================
+// Boot Timeline
+// ============================================================================
+
+// Startup phases remembered for /debug/boot and GUI.dumpBootReport()
+// (WebGUIBoot.h), 12 bytes each. Auto-discovery records six, a plain
+// connectWiFi() three, settings and begin() one each; 0 removes it.
+#ifndef WEBGUI_BOOT_TIMELINE_SIZE
+  #if defined(ESP32)
+    #define WEBGUI_BOOT_TIMELINE_SIZE 12
+  #else
+    #define WEBGUI_BOOT_TIMELINE_SIZE 8
+  #endif
+#endif
+
+// connectWiFi() and friends give up after this long without a connection,
+// checking every WEBGUI_WIFI_POLL_MS
+#ifndef WEBGUI_WIFI_TIMEOUT_MS
+  #define WEBGUI_WIFI_TIMEOUT_MS 30000
+#endif
+
+#ifndef WEBGUI_WIFI_POLL_MS
+  #define WEBGUI_WIFI_POLL_MS 100
+#endif
+
+// ============================================================================
+// Request Capture
+// ============================================================================
+
+// Bytes of RAM for recording raw requests as they arrive (WebGUICapture.h),
+// exported at /debug/capture and by GUI.dumpCapture() and replayed by the
+// host build's replay tool. Each request costs its own bytes plus 6; a
+// browser's /get is about 300. Recording starts with GUI.startCapture() or
+// /debug/capture?start and drops the oldest requests when full. 0 (default)
+// removes it.
+#ifndef WEBGUI_CAPTURE_SIZE
+  #define WEBGUI_CAPTURE_SIZE 0
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+/*
+  WebGUIElementList.h - Storage for the elements registered with WebGUI
+
+  With WEBGUI_MAX_ELEMENTS set to 0 (default) the list is a std::vector and
+  grows as elements are added. Set it to the panel size to use a std::array
+  instead: the list is then a fixed part of the WebGUI object, never
+  reallocates, and its memory use is known at link time.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIElementList_h
+#define WebGUIElementList_h
+
+#include "WebGUIConfig.h"
+
+#if WEBGUI_MAX_ELEMENTS > 0
+  #include <array>
+#else
+  #include <vector>
+#endif
+
+class GUIElement;
+
+class WebGUIElementList {
+  public:
+#if WEBGUI_MAX_ELEMENTS > 0
+    WebGUIElementList() : count(0) {}
+
+    // Returns false when the list already holds WEBGUI_MAX_ELEMENTS elements
+    bool add(GUIElement* element) {
+        if (count >= items.size()) {
+            return false;
+        }
+        items[count++] = element;
+        return true;
+    }
+
+    size_t size() const { return count; }
+    static size_t capacity() { return WEBGUI_MAX_ELEMENTS; }
+    GUIElement* operator[](size_t index) const { return items[index]; }
+    GUIElement* const* begin() const { return items.data(); }
+    GUIElement* const* end() const { return items.data() + count; }
+
+  private:
+    std::array<GUIElement*, WEBGUI_MAX_ELEMENTS> items;
+    size_t count;
+#else
+    bool add(GUIElement* element) {
+        items.push_back(element);
+        return true;
+    }
+
+    size_t size() const { return items.size(); }
+    size_t capacity() const { return items.capacity(); }
+    GUIElement* operator[](size_t index) const { return items[index]; }
+    GUIElement* const* begin() const { return items.data(); }
+    GUIElement* const* end() const { return items.data() + items.size(); }
+
+  private:
+    std::vector<GUIElement*> items;
+#endif
+};
+
+#endif
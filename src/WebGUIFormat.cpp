@@ -0,0 +1,112 @@
+/*
+  WebGUIFormat.cpp - Allocation-free number formatting for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUIFormat.h"
+
+static const uint32_t POWERS_OF_TEN[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+
+// Digits of value right-aligned in the width given (zero padded), or
+// just the digits if width is 0; returns the number written
+static size_t writeDigits(char* buffer, uint32_t value, size_t width) {
+    char digits[10];
+    size_t count = 0;
+    do {
+        digits[count++] = '0' + (value % 10);
+        value /= 10;
+    } while (value);
+    while (count < width) {
+        digits[count++] = '0';
+    }
+    for (size_t i = 0; i < count; i++) {
+        buffer[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+size_t webguiFormatInt(char* buffer, long value) {
+    size_t length = 0;
+    uint32_t magnitude = (uint32_t)value;
+    if (value < 0) {
+        buffer[length++] = '-';
+        magnitude = 0u - magnitude;
+    }
+    length += writeDigits(buffer + length, magnitude, 0);
+    buffer[length] = '\0';
+    return length;
+}
+
+size_t webguiFormatFloat(char* buffer, float value, int decimals) {
+    decimals = constrain(decimals, 0, 7);
+    
+    if (isnan(value)) {
+        strcpy(buffer, "nan");
+        return 3;
+    }
+    if (isinf(value)) {
+        strcpy(buffer, value < 0 ? "-inf" : "inf");
+        return strlen(buffer);
+    }
+    
+    float magnitude = fabsf(value);
+    if (magnitude >= 4294967295.0f) {
+        dtostrf(value, 1, decimals, buffer);  // Integer part won't fit in 32 bits
+        return strlen(buffer);
+    }
+    
+    // The float as significand / 2^shift, both exact, so the fraction is
+    // scaled and rounded once in integers with no double math: 24 bits
+    // times at most 10^7 fits in 64. 0.996 with two decimals carries into
+    // the integer part as 1.00.
+    int exponent;
+    uint32_t significand = (uint32_t)(frexpf(magnitude, &exponent) * 16777216.0f);
+    int shift = 24 - exponent;
+    uint32_t whole = 0;
+    uint32_t fraction = 0;
+    if (shift <= 0) {
+        whole = significand << -shift;
+    } else if (shift < 64) {
+        uint64_t bits = significand;
+        whole = (uint32_t)(bits >> shift);
+        uint64_t fractionBits = bits & ((1ULL << shift) - 1);
+        fraction = (uint32_t)((fractionBits * POWERS_OF_TEN[decimals] + (1ULL << (shift - 1))) >> shift);
+    }   // Otherwise below 2^-40: rounds to 0 at any decimals
+    if (fraction >= POWERS_OF_TEN[decimals]) {
+        fraction -= POWERS_OF_TEN[decimals];
+        whole++;
+    }
+    
+    size_t length = 0;
+    if (value < 0 && (whole || fraction)) {
+        buffer[length++] = '-';
+    }
+    length += writeDigits(buffer + length, whole, 0);
+    if (decimals > 0) {
+        buffer[length++] = '.';
+        length += writeDigits(buffer + length, fraction, decimals);
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+void webguiPrintRight(Print& out, unsigned long value, uint8_t width) {
+    unsigned long limit = 10;
+    uint8_t digits = 1;
+    while (digits < width && value >= limit) {
+        digits++;
+        limit *= 10;
+    }
+    for (uint8_t i = digits; i < width; i++) {
+        out.print(' ');
+    }
+    out.print(value);
+}
+
+void webguiPrintLeft(Print& out, const char* text, uint8_t width) {
+    out.print(text);
+    for (size_t i = strlen(text); i < width; i++) {
+        out.print(' ');
+    }
+}
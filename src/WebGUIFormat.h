@@ -0,0 +1,33 @@
+/*
+  WebGUIFormat.h - Allocation-free number formatting for the WebGUI Library
+
+  Writes numbers straight into a caller-supplied char buffer. Integer
+  arithmetic only for the common case, so formatting a float does not pull
+  in printf or allocate a String. Also pads the table columns of the
+  diagnostic dumps.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIFormat_h
+#define WebGUIFormat_h
+
+#include "Arduino.h"
+
+// Big enough for any value the functions below produce, terminator included
+#define WEBGUI_INT_BUFFER_SIZE 12
+#define WEBGUI_FLOAT_BUFFER_SIZE 50
+
+// Decimal integer; returns the number of characters written
+size_t webguiFormatInt(char* buffer, long value);
+
+// Fixed-point with 0-7 decimals, like dtostrf(value, 1, decimals, buffer).
+// Rounds half away from zero. Returns the number of characters written.
+size_t webguiFormatFloat(char* buffer, float value, int decimals);
+
+// Table columns: the value right-aligned or the text left-aligned, padded
+// with spaces to width. Longer values are printed in full.
+void webguiPrintRight(Print& out, unsigned long value, uint8_t width);
+void webguiPrintLeft(Print& out, const char* text, uint8_t width);
+
+#endif
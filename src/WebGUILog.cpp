@@ -0,0 +1,93 @@
+/*
+  WebGUILog.cpp - Buffered log output for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUILog.h"
+
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+
+WebGUILogBuffer webguiLog(WEBGUI_LOG_OUTPUT);
+
+WebGUILogBuffer::WebGUILogBuffer(Print& output)
+    : output(output), head(0), drained(0), dropped(0), deferred(false) {
+}
+
+size_t WebGUILogBuffer::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t WebGUILogBuffer::write(const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        text[head % WEBGUI_LOG_BUFFER_SIZE] = (char)data[i];
+        head++;
+    }
+
+    // The oldest unwritten text is overwritten rather than blocking
+    if (head - drained > WEBGUI_LOG_BUFFER_SIZE) {
+        dropped += head - drained - WEBGUI_LOG_BUFFER_SIZE;
+        drained = head - WEBGUI_LOG_BUFFER_SIZE;
+    }
+
+    // Outside update() nobody is waiting on a response, so write through
+    if (!deferred) {
+        writePending(pending());
+    }
+    return size;
+}
+
+size_t WebGUILogBuffer::drain() {
+    if (head == drained) {
+        return 0;
+    }
+    // 0 may only mean the output doesn't report its room
+    int room = output.availableForWrite();
+    size_t limit = room > 0 ? (size_t)room : WEBGUI_LOG_DRAIN_CHUNK;
+    if (limit > pending()) {
+        limit = pending();
+    }
+    writePending(limit);
+    return limit;
+}
+
+// Up to limit queued bytes, in at most two writes around the wrap point
+void WebGUILogBuffer::writePending(size_t limit) {
+    while (limit > 0) {
+        size_t start = drained % WEBGUI_LOG_BUFFER_SIZE;
+        size_t chunk = WEBGUI_LOG_BUFFER_SIZE - start;
+        if (chunk > limit) {
+            chunk = limit;
+        }
+        output.write((const uint8_t*)text + start, chunk);
+        drained += chunk;
+        limit -= chunk;
+    }
+}
+
+void WebGUILogBuffer::dump(Print& out) const {
+    size_t held = head < WEBGUI_LOG_BUFFER_SIZE ? head : WEBGUI_LOG_BUFFER_SIZE;
+    uint32_t position = head - held;
+
+    // Once the ring has wrapped, its first line is a fragment
+    if (head > WEBGUI_LOG_BUFFER_SIZE) {
+        while (position != head && text[position % WEBGUI_LOG_BUFFER_SIZE] != '\n') {
+            position++;
+        }
+        if (position != head) {
+            position++;
+        }
+    }
+
+    while (position != head) {
+        size_t start = position % WEBGUI_LOG_BUFFER_SIZE;
+        size_t chunk = WEBGUI_LOG_BUFFER_SIZE - start;
+        if (chunk > head - position) {
+            chunk = head - position;
+        }
+        out.write((const uint8_t*)text + start, chunk);
+        position += chunk;
+    }
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+  WebGUILog.h - Leveled logging for the WebGUI Library
+
+  Library messages go through WEBGUI_LOG_ERROR(), _WARN(), _INFO() and
+  _DEBUG(). Each takes any number of printable arguments and prints them as
+  one line:
+
+    WEBGUI_LOG_INFO("WebGUI server started on port ", serverPort);
+
+  A level above WEBGUI_LOG_LEVEL expands to a dead if (false) branch: the
+  arguments are still type-checked, so disabled messages can't go stale,
+  but they are never evaluated and the compiler drops the code and its
+  strings entirely. Any String they would build costs nothing.
+
+  With WEBGUI_LOG_BUFFER_SIZE > 0 messages go to webguiLog, a fixed ring
+  of recent text. Outside update() it writes straight through to
+  WEBGUI_LOG_OUTPUT. Inside update() it only copies into RAM, and idle
+  update() calls pass the text on, no faster than the output can take it
+  without blocking. Whatever the ring still holds is served at /debug/log.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUILog_h
+#define WebGUILog_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+inline void webguiLogPrint(Print& out) {
+    (void)out;
+}
+
+// Prints each argument in turn, without building an intermediate String
+template <typename T, typename... Rest>
+inline void webguiLogPrint(Print& out, const T& first, const Rest&... rest) {
+    out.print(first);
+    webguiLogPrint(out, rest...);
+}
+
+#if WEBGUI_LOG_BUFFER_SIZE > 0
+
+class WebGUILogBuffer : public Print {
+  public:
+    explicit WebGUILogBuffer(Print& output);
+    
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+    
+    // While deferred, text is only queued. Leaving deferred mode writes
+    // nothing by itself; the next drain() or direct write catches up.
+    void setDeferred(bool deferred) { this->deferred = deferred; }
+    
+    // Writes queued text as far as output.availableForWrite() allows, so
+    // it never waits on the output; when that reports 0, which outputs
+    // without the call do, WEBGUI_LOG_DRAIN_CHUNK bytes. Returns the bytes
+    // written.
+    size_t drain();
+    
+    // Queued text not yet written to the output
+    size_t pending() const { return (size_t)(head - drained); }
+    
+    // Bytes overwritten before they could be written to the output
+    uint32_t getDropped() const { return dropped; }
+    
+    // Everything still held, oldest first, starting at a line boundary
+    void dump(Print& out) const;
+    
+  private:
+    void writePending(size_t limit);
+    
+    Print& output;
+    char text[WEBGUI_LOG_BUFFER_SIZE];
+    uint32_t head;     // Bytes ever written; the next one goes to head % size
+    uint32_t drained;  // Bytes passed on to the output (or dropped)
+    uint32_t dropped;
+    bool deferred;
+};
+
+extern WebGUILogBuffer webguiLog;
+
+  #define WEBGUI_LOG_SINK webguiLog
+#else
+  #define WEBGUI_LOG_SINK WEBGUI_LOG_OUTPUT
+#endif
+
+#define WEBGUI_LOG_LINE(...) do { \
+        webguiLogPrint(WEBGUI_LOG_SINK, __VA_ARGS__); \
+        WEBGUI_LOG_SINK.println(); \
+    } while (0)
+
+#define WEBGUI_LOG_NOTHING(...) do { \
+        if (false) webguiLogPrint(WEBGUI_LOG_SINK, __VA_ARGS__); \
+    } while (0)
+
+#if WEBGUI_LOG_LEVEL >= WEBGUI_LOG_LEVEL_ERROR
+  #define WEBGUI_LOG_ERROR(...) WEBGUI_LOG_LINE(__VA_ARGS__)
+#else
+  #define WEBGUI_LOG_ERROR(...) WEBGUI_LOG_NOTHING(__VA_ARGS__)
+#endif
+
+#if WEBGUI_LOG_LEVEL >= WEBGUI_LOG_LEVEL_WARN
+  #define WEBGUI_LOG_WARN(...) WEBGUI_LOG_LINE(__VA_ARGS__)
+#else
+  #define WEBGUI_LOG_WARN(...) WEBGUI_LOG_NOTHING(__VA_ARGS__)
+#endif
+
+#if WEBGUI_LOG_LEVEL >= WEBGUI_LOG_LEVEL_INFO
+  #define WEBGUI_LOG_INFO(...) WEBGUI_LOG_LINE(__VA_ARGS__)
+  // One dot per second while waiting for WiFi, finished by the next line
+  #define WEBGUI_LOG_PROGRESS() WEBGUI_LOG_SINK.print('.')
+#else
+  #define WEBGUI_LOG_INFO(...) WEBGUI_LOG_NOTHING(__VA_ARGS__)
+  #define WEBGUI_LOG_PROGRESS() WEBGUI_LOG_NOTHING('.')
+#endif
+
+#if WEBGUI_LOG_LEVEL >= WEBGUI_LOG_LEVEL_DEBUG
+  #define WEBGUI_LOG_DEBUG(...) WEBGUI_LOG_LINE(__VA_ARGS__)
+#else
+  #define WEBGUI_LOG_DEBUG(...) WEBGUI_LOG_NOTHING(__VA_ARGS__)
+#endif
+
+#endif
@@ -0,0 +1,141 @@
+/*
+  WebGUIMemory.cpp - Heap and stack telemetry for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUIMemory.h"
+
+#if WEBGUI_ESP_HEAP_API
+
+// ESP-IDF tracks everything itself, including the minimum free heap
+
+void initMemoryStats() {
+}
+
+void sampleMemoryStats() {
+}
+
+uint32_t getFreeHeap() {
+    return ESP.getFreeHeap();
+}
+
+WebGUIMemoryStats getMemoryStats() {
+    WebGUIMemoryStats stats;
+    stats.freeHeap = ESP.getFreeHeap();
+    stats.largestFreeBlock = ESP.getMaxAllocHeap();
+    stats.minFreeHeap = ESP.getMinFreeHeap();
+    stats.stackHighWaterMark = uxTaskGetStackHighWaterMark(NULL);  // Calling task, in bytes on ESP-IDF
+    return stats;
+}
+
+#else
+
+// Nano 33 IoT (SAMD21) and UNO R4 WiFi (RA4M1) both use newlib's malloc on
+// top of sbrk(). Free heap is the untouched gap above the heap plus the free
+// chunks malloc holds on to.
+
+#include <malloc.h>
+
+extern "C" char* sbrk(int increment);
+
+// Linker script symbols. Weak, so a core that doesn't define one links
+// anyway and the symbol's address reads as nullptr.
+extern "C" char __HeapLimit __attribute__((weak));
+extern "C" char __StackLimit __attribute__((weak));
+
+static const uint8_t STACK_PAINT = 0xA5;
+static const size_t STACK_GUARD = 128;  // Never paint right up to the live stack
+
+static char* stackBottom = nullptr;     // Lowest address the painted stack covers
+static uint32_t minFreeHeapSeen = UINT32_MAX;
+
+static inline char* currentStackPointer() {
+    return static_cast<char*>(__builtin_frame_address(0));
+}
+
+// Where the heap has to stop: at the stack when they share the free gap,
+// or at the end of a dedicated heap region (UNO R4 FSP layout)
+static char* heapLimit(char* stackPointer, char* heapEnd) {
+    char* regionEnd = &__HeapLimit;
+    if (regionEnd && regionEnd > heapEnd && (stackPointer < heapEnd || regionEnd < stackPointer)) {
+        return regionEnd;
+    }
+    return stackPointer;
+}
+
+static uint32_t freeHeapNow() {
+    char* stackPointer = currentStackPointer();
+    char* heapEnd = sbrk(0);
+    char* limit = heapLimit(stackPointer, heapEnd);
+    uint32_t gap = limit > heapEnd ? (uint32_t)(limit - heapEnd) : 0;
+    return gap + mallinfo().fordblks;
+}
+
+void initMemoryStats() {
+    char* stackPointer = currentStackPointer();
+    char* heapEnd = sbrk(0);
+    
+    // A separate stack region starts at __StackLimit; otherwise the stack
+    // grows down towards the top of the heap
+    char* bottom = &__StackLimit;
+    if (!bottom || bottom > stackPointer || (heapEnd > bottom && heapEnd < stackPointer)) {
+        bottom = heapEnd;
+    }
+    
+    if (stackPointer - STACK_GUARD > bottom) {
+        for (volatile char* p = bottom; p < stackPointer - STACK_GUARD; p++) {
+            *p = STACK_PAINT;
+        }
+        stackBottom = bottom;
+    }
+    sampleMemoryStats();
+}
+
+void sampleMemoryStats() {
+    uint32_t freeHeap = freeHeapNow();
+    if (freeHeap < minFreeHeapSeen) {
+        minFreeHeapSeen = freeHeap;
+    }
+}
+
+uint32_t getFreeHeap() {
+    return freeHeapNow();
+}
+
+// Untouched paint above the bottom of the stack region is stack that has
+// never been used
+static uint32_t stackHighWaterMark() {
+    if (!stackBottom) {
+        return 0;
+    }
+    char* stackPointer = currentStackPointer();
+    char* bottom = stackBottom;
+    char* heapEnd = sbrk(0);
+    if (heapEnd > bottom && heapEnd < stackPointer) {
+        bottom = heapEnd;  // The heap has since grown into the painted area
+    }
+    char* p = bottom;
+    while (p < stackPointer && *(volatile uint8_t*)p == STACK_PAINT) {
+        p++;
+    }
+    return (uint32_t)(p - bottom);
+}
+
+WebGUIMemoryStats getMemoryStats() {
+    sampleMemoryStats();
+    
+    char* heapEnd = sbrk(0);
+    char* limit = heapLimit(currentStackPointer(), heapEnd);
+    
+    WebGUIMemoryStats stats;
+    stats.freeHeap = freeHeapNow();
+    // newlib keeps no cheap record of its largest free chunk, so report the
+    // contiguous gap above the heap (a lower bound)
+    stats.largestFreeBlock = limit > heapEnd ? (uint32_t)(limit - heapEnd) : 0;
+    stats.minFreeHeap = minFreeHeapSeen;
+    stats.stackHighWaterMark = stackHighWaterMark();
+    return stats;
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+  WebGUIMemory.h - Heap and stack telemetry for the WebGUI Library
+
+  Per-platform implementations live in WebGUIMemory.cpp:
+  - ESP32 (WEBGUI_ESP_HEAP_API): ESP-IDF heap and FreeRTOS task statistics
+  - Nano 33 IoT / UNO R4 WiFi: newlib heap (sbrk + mallinfo) plus a painted
+    stack region scanned for the deepest write
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIMemory_h
+#define WebGUIMemory_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+struct WebGUIMemoryStats {
+    uint32_t freeHeap;            // Bytes malloc could still hand out in total
+    uint32_t largestFreeBlock;    // Biggest single allocation that would succeed
+    uint32_t minFreeHeap;         // Lowest freeHeap seen since boot
+    uint32_t stackHighWaterMark;  // Least unused stack seen since initMemoryStats()
+};
+
+// Paint the unused stack so its high-water mark can be measured later.
+// WebGUI::begin() calls this; call it earlier to cover setup() as well.
+void initMemoryStats();
+
+// Record the current free heap towards minFreeHeap. Cheap enough to call
+// after every request; WebGUI::update() does.
+void sampleMemoryStats();
+
+// Current free heap only; cheaper than getMemoryStats() for frequent polling
+uint32_t getFreeHeap();
+
+// Full snapshot. Scans the painted stack, so avoid calling it every loop.
+WebGUIMemoryStats getMemoryStats();
+
+#endif
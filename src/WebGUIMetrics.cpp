@@ -0,0 +1,143 @@
+/*
+  WebGUIMetrics.cpp - Request and loop timing counters for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUIMetrics.h"
+#include "WebGUIMemory.h"
+
+uint32_t WebGUIHistogram::percentile(float fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t target = (uint32_t)(fraction * count);
+    if (target < 1) target = 1;
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            return i == BUCKETS - 1 ? maxValue : bucketLimit(i);
+        }
+    }
+    return maxValue;
+}
+
+const char* webguiRouteName(int route) {
+    static const char* const NAMES[WEBGUI_ROUTES] = { "page", "get", "set", "metrics", "trace", "log", "boot", "capture", "other" };
+    return route >= 0 && route < WEBGUI_ROUTES ? NAMES[route] : "none";
+}
+
+#if WEBGUI_METRICS
+
+// Not every core's Print handles 64-bit integers
+static void printUint64(Print& out, uint64_t value) {
+    char digits[21];
+    int i = sizeof(digits) - 1;
+    digits[i] = '\0';
+    do {
+        digits[--i] = '0' + (value % 10);
+        value /= 10;
+    } while (value);
+    out.print(&digits[i]);
+}
+
+static void printType(Print& out, const char* name, const char* type) {
+    out.print("# TYPE ");
+    out.print(name);
+    out.print(' ');
+    out.println(type);
+}
+
+static void printSample(Print& out, const char* name, uint32_t value) {
+    out.print(name);
+    out.print(' ');
+    out.println(value);
+}
+
+static void printRouteSample(Print& out, const char* name, int route, uint32_t value) {
+    out.print(name);
+    out.print("{route=\"");
+    out.print(webguiRouteName(route));
+    out.print("\"} ");
+    out.println(value);
+}
+
+void WebGUIMetrics::stream(Print& out, const WebGUIHistogram& updateTimes) const {
+    printType(out, "webgui_requests_total", "counter");
+    for (int r = 0; r < WEBGUI_ROUTES; r++) {
+        printRouteSample(out, "webgui_requests_total", r, routes[r].requests);
+    }
+    printType(out, "webgui_request_bytes_total", "counter");
+    for (int r = 0; r < WEBGUI_ROUTES; r++) {
+        printRouteSample(out, "webgui_request_bytes_total", r, routes[r].bytesIn);
+    }
+    printType(out, "webgui_response_bytes_total", "counter");
+    for (int r = 0; r < WEBGUI_ROUTES; r++) {
+        printRouteSample(out, "webgui_response_bytes_total", r, routes[r].bytesOut);
+    }
+    
+    // Buckets only for routes that have seen traffic, to keep the page short
+    printType(out, "webgui_request_duration_us", "histogram");
+    for (int r = 0; r < WEBGUI_ROUTES; r++) {
+        const WebGUIHistogram& h = routes[r].latency;
+        if (h.getCount() == 0) {
+            continue;
+        }
+        uint32_t cumulative = 0;
+        for (int b = 0; b < WebGUIHistogram::BUCKETS; b++) {
+            cumulative += h.getBucket(b);
+            out.print("webgui_request_duration_us_bucket{route=\"");
+            out.print(webguiRouteName(r));
+            out.print("\",le=\"");
+            if (b == WebGUIHistogram::BUCKETS - 1) {
+                out.print("+Inf");
+            } else {
+                out.print(WebGUIHistogram::bucketLimit(b));
+            }
+            out.print("\"} ");
+            out.println(cumulative);
+        }
+        out.print("webgui_request_duration_us_sum{route=\"");
+        out.print(webguiRouteName(r));
+        out.print("\"} ");
+        printUint64(out, h.getSum());
+        out.println();
+        printRouteSample(out, "webgui_request_duration_us_count", r, h.getCount());
+    }
+    
+    printType(out, "webgui_update_duration_us", "summary");
+    static const float QUANTILES[] = { 0.5f, 0.9f, 0.99f };
+    static const char* const QUANTILE_NAMES[] = { "0.5", "0.9", "0.99" };
+    for (int q = 0; q < 3; q++) {
+        out.print("webgui_update_duration_us{quantile=\"");
+        out.print(QUANTILE_NAMES[q]);
+        out.print("\"} ");
+        out.println(updateTimes.percentile(QUANTILES[q]));
+    }
+    out.print("webgui_update_duration_us_sum ");
+    printUint64(out, updateTimes.getSum());
+    out.println();
+    printSample(out, "webgui_update_duration_us_count", updateTimes.getCount());
+    printType(out, "webgui_update_duration_max_us", "gauge");
+    printSample(out, "webgui_update_duration_max_us", updateTimes.getMax());
+    
+    printType(out, "webgui_connections_total", "counter");
+    printSample(out, "webgui_connections_total", connectionsOpened);
+    printType(out, "webgui_active_connections", "gauge");
+    printSample(out, "webgui_active_connections", getActiveConnections());
+    printType(out, "webgui_settings_writes_total", "counter");
+    printSample(out, "webgui_settings_writes_total", settingsWrites);
+    
+    WebGUIMemoryStats memory = getMemoryStats();
+    printType(out, "webgui_heap_free_bytes", "gauge");
+    printSample(out, "webgui_heap_free_bytes", memory.freeHeap);
+    printType(out, "webgui_heap_largest_block_bytes", "gauge");
+    printSample(out, "webgui_heap_largest_block_bytes", memory.largestFreeBlock);
+    printType(out, "webgui_heap_min_free_bytes", "gauge");
+    printSample(out, "webgui_heap_min_free_bytes", memory.minFreeHeap);
+    printType(out, "webgui_stack_free_bytes", "gauge");
+    printSample(out, "webgui_stack_free_bytes", memory.stackHighWaterMark);
+}
+
+#endif
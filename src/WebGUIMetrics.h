@@ -0,0 +1,140 @@
+/*
+  WebGUIMetrics.h - Request and loop timing counters for the WebGUI Library
+
+  Fixed-size counters updated with a few integer operations per request, so
+  they can stay enabled on field devices. WebGUI serves them at /metrics in
+  Prometheus text format.
+
+  Durations go into log2 histograms: bucket 0 counts durations up to 1 us,
+  bucket k those over 2^(k-1) and up to 2^k us, and the last bucket
+  everything longer. Percentiles read from them are the upper bound of the bucket they
+  fall in, i.e. accurate to a factor of two.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIMetrics_h
+#define WebGUIMetrics_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+enum WebGUIRoute {
+    WEBGUI_ROUTE_PAGE,
+    WEBGUI_ROUTE_GET,
+    WEBGUI_ROUTE_SET,
+    WEBGUI_ROUTE_METRICS,
+    WEBGUI_ROUTE_TRACE,
+    WEBGUI_ROUTE_LOG,
+    WEBGUI_ROUTE_BOOT,
+    WEBGUI_ROUTE_CAPTURE,
+    WEBGUI_ROUTE_OTHER,     // Rejected requests (request line too long)
+    WEBGUI_ROUTES,
+    WEBGUI_ROUTE_NONE = WEBGUI_ROUTES   // No request was served
+};
+
+// "page", "get", ... as used in /metrics labels and the request trace
+const char* webguiRouteName(int route);
+
+class WebGUIHistogram {
+  public:
+    static const int BUCKETS = 24;   // Last bucket: over 2^22 us (~4 s)
+
+    WebGUIHistogram() { reset(); }
+
+    void add(uint32_t micros) {
+        buckets[bucketFor(micros)]++;
+        count++;
+        sum += micros;
+        if (micros > maxValue) maxValue = micros;
+    }
+
+    void reset() {
+        memset(buckets, 0, sizeof(buckets));
+        count = 0;
+        sum = 0;
+        maxValue = 0;
+    }
+
+    // Upper bound of the bucket holding the given fraction of samples
+    // (0.99 for p99); 0 with no samples
+    uint32_t percentile(float fraction) const;
+
+    uint32_t getCount() const { return count; }
+    uint64_t getSum() const { return sum; }
+    uint32_t getMax() const { return maxValue; }
+    uint32_t getBucket(int index) const { return buckets[index]; }
+
+    // Inclusive upper bound of a bucket in microseconds (the Prometheus
+    // le label); UINT32_MAX for the last
+    static uint32_t bucketLimit(int index) {
+        return index >= BUCKETS - 1 ? UINT32_MAX : (uint32_t)1 << index;
+    }
+
+    static int bucketFor(uint32_t micros) {
+        if (micros <= 1) return 0;
+        int bits = 32 - __builtin_clz(micros - 1);   // 2 -> 1, 3..4 -> 2, 5..8 -> 3
+        return bits < BUCKETS - 1 ? bits : BUCKETS - 1;
+    }
+
+  private:
+    uint32_t buckets[BUCKETS];
+    uint32_t count;
+    uint64_t sum;
+    uint32_t maxValue;
+};
+
+struct WebGUIRouteMetrics {
+    WebGUIRouteMetrics() : requests(0), bytesIn(0), bytesOut(0) {}
+
+    uint32_t requests;
+    uint32_t bytesIn;
+    uint32_t bytesOut;
+    WebGUIHistogram latency;
+};
+
+#if WEBGUI_METRICS
+
+class WebGUIMetrics {
+  public:
+    WebGUIMetrics() : connectionsOpened(0), connectionsClosed(0), settingsWrites(0) {}
+
+    void recordRequest(WebGUIRoute route, uint32_t bytesIn, uint32_t bytesOut, uint32_t micros) {
+        WebGUIRouteMetrics& r = routes[route];
+        r.requests++;
+        r.bytesIn += bytesIn;
+        r.bytesOut += bytesOut;
+        r.latency.add(micros);
+    }
+    void connectionOpened() { connectionsOpened++; }
+    void connectionClosed() { connectionsClosed++; }
+    void settingWritten() { settingsWrites++; }
+
+    const WebGUIRouteMetrics& getRoute(WebGUIRoute route) const { return routes[route]; }
+    uint32_t getActiveConnections() const { return connectionsOpened - connectionsClosed; }
+    uint32_t getConnections() const { return connectionsOpened; }
+    uint32_t getSettingsWrites() const { return settingsWrites; }
+
+    // Everything above plus update() timings in Prometheus text format
+    void stream(Print& out, const WebGUIHistogram& updateTimes) const;
+
+  private:
+    WebGUIRouteMetrics routes[WEBGUI_ROUTES];
+    uint32_t connectionsOpened;
+    uint32_t connectionsClosed;
+    uint32_t settingsWrites;
+};
+
+#else
+
+class WebGUIMetrics {
+  public:
+    void recordRequest(WebGUIRoute, uint32_t, uint32_t, uint32_t) {}
+    void connectionOpened() {}
+    void connectionClosed() {}
+    void settingWritten() {}
+};
+
+#endif
+
+#endif
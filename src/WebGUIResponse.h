@@ -0,0 +1,163 @@
+/*
+  WebGUIResponse.h - Buffered response output for the WebGUI Library
+
+  WebGUIResponseWriter collects small print() calls into a buffer taken from
+  the request arena and hands them to the network in large writes. On the
+  WiFiNINA and WiFiS3 modules every client write is a separate bus
+  transaction, so batching them is much cheaper than printing piecewise.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIResponse_h
+#define WebGUIResponse_h
+
+#include "Arduino.h"
+#include "WebGUIArena.h"
+#include "WebGUIAllocStats.h"
+
+class WebGUIResponseWriter : public Print {
+  public:
+    // Falls back to unbuffered writes if the arena has no room left
+    WebGUIResponseWriter(Print& sink, WebGUIArena& arena, size_t bufferSize = WEBGUI_RESPONSE_BUFFER_SIZE)
+        : sink(sink), buffer(arena.allocateChars(bufferSize)), capacity(buffer ? bufferSize : 0),
+          length(0), total(0), sinkMicros(0) {}
+
+    ~WebGUIResponseWriter() { flush(); }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        total += size;
+        if (size >= capacity) {
+            flush();
+            WebGUIHeapExempt networkCall;  // The sink is usually a WiFi client
+            unsigned long start = micros();
+            size_t written = sink.write(data, size);
+            sinkMicros += micros() - start;
+            return written;
+        }
+        if (length + size > capacity) {
+            flush();
+        }
+        memcpy(buffer + length, data, size);
+        length += size;
+        return size;
+    }
+
+    using Print::write;
+
+    void flush() override {
+        if (length > 0) {
+            WebGUIHeapExempt networkCall;
+            unsigned long start = micros();
+            sink.write(reinterpret_cast<const uint8_t*>(buffer), length);
+            sinkMicros += micros() - start;
+            length = 0;
+        }
+    }
+
+    // Bytes written so far, buffered or not
+    size_t bytesWritten() const { return total; }
+    
+    // Time spent inside the sink's write(), i.e. sending rather than rendering
+    unsigned long getSinkMicros() const { return sinkMicros; }
+
+  private:
+    Print& sink;
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    size_t total;
+    unsigned long sinkMicros;
+};
+
+// Escapes everything printed through it for use inside a JSON string literal
+class WebGUIJSONEscaper : public Print {
+  public:
+    explicit WebGUIJSONEscaper(Print& target) : target(target) {}
+
+    size_t write(uint8_t c) override {
+        switch (c) {
+            case '"':  return target.write((const uint8_t*)"\\\"", 2);
+            case '\\': return target.write((const uint8_t*)"\\\\", 2);
+            case '\n': return target.write((const uint8_t*)"\\n", 2);
+            case '\r': return target.write((const uint8_t*)"\\r", 2);
+            case '\t': return target.write((const uint8_t*)"\\t", 2);
+        }
+        if (c < 0x20) {
+            static const char hex[] = "0123456789abcdef";
+            uint8_t escaped[6] = {'\\', 'u', '0', '0', (uint8_t)hex[c >> 4], (uint8_t)hex[c & 0x0F]};
+            return target.write(escaped, sizeof(escaped));
+        }
+        return target.write(c);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        // Pass runs of plain characters through in one call
+        size_t start = 0;
+        for (size_t i = 0; i < size; i++) {
+            if (data[i] < 0x20 || data[i] == '"' || data[i] == '\\') {
+                if (i > start) target.write(data + start, i - start);
+                write(data[i]);
+                start = i + 1;
+            }
+        }
+        if (size > start) target.write(data + start, size - start);
+        return size;
+    }
+
+    using Print::write;
+
+  private:
+    Print& target;
+};
+
+// Appends to a String; lets the streaming code back the String-returning API
+class WebGUIStringPrint : public Print {
+  public:
+    explicit WebGUIStringPrint(String& target) : target(target) {}
+
+    size_t write(uint8_t c) override {
+        target += (char)c;
+        return 1;
+    }
+    size_t write(const uint8_t* data, size_t size) override {
+        target.reserve(target.length() + size);
+        for (size_t i = 0; i < size; i++) {
+            target += (char)data[i];
+        }
+        return size;
+    }
+
+  private:
+    String& target;
+};
+
+// Writes into a fixed char buffer, always terminated; text that doesn't fit
+// is dropped
+class WebGUIBufferPrint : public Print {
+  public:
+    WebGUIBufferPrint(char* buffer, size_t size) : buffer(buffer), size(size), length(0) {
+        buffer[0] = '\0';
+    }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t count) override {
+        size_t room = size - 1 - length;
+        if (count > room) count = room;
+        memcpy(buffer + length, data, count);
+        length += count;
+        buffer[length] = '\0';
+        return count;
+    }
+
+    const char* c_str() const { return buffer; }
+
+  private:
+    char* buffer;
+    size_t size;
+    size_t length;
+};
+
+#endif
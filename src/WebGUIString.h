@@ -0,0 +1,189 @@
+/*
+  WebGUIString.h - Fixed-capacity inline strings for element state
+
+  WebGUIFixedString<N> keeps up to N characters in a buffer inside the
+  owning object. Assigning to it copies into that buffer and never touches
+  the heap, so elements that are updated every loop iteration (sensor
+  readings, text box values) cannot fragment memory over long uptimes.
+
+  Enabled with WEBGUI_INLINE_STRINGS (see WebGUIConfig.h). It converts to
+  String implicitly, so the public element API keeps returning String.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUIString_h
+#define WebGUIString_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+
+// What an assignment does with text longer than the capacity
+enum WebGUITruncation {
+    WEBGUI_TRUNCATE,            // keep the first N characters
+    WEBGUI_TRUNCATE_ELLIPSIS,   // keep the first N-3 characters followed by "..."
+    WEBGUI_KEEP_PREVIOUS        // reject the new text and keep the current value
+};
+
+template <size_t Capacity, WebGUITruncation Policy = WEBGUI_TRUNCATE>
+class WebGUIFixedString {
+  public:
+    WebGUIFixedString() : len(0) { buffer[0] = '\0'; }
+    WebGUIFixedString(const char* text) : len(0) { buffer[0] = '\0'; assign(text); }
+    WebGUIFixedString(const String& text) : len(0) { buffer[0] = '\0'; assign(text.c_str(), text.length()); }
+
+    WebGUIFixedString& operator=(const char* text) { assign(text); return *this; }
+    WebGUIFixedString& operator=(const String& text) { assign(text.c_str(), text.length()); return *this; }
+
+    // Returns false if the text was shortened or, with WEBGUI_KEEP_PREVIOUS, rejected
+    bool assign(const char* text) { return assign(text, text ? strlen(text) : 0); }
+
+    bool assign(const char* text, size_t textLength) {
+        if (textLength <= Capacity) {
+            memmove(buffer, text, textLength);
+            setLength(textLength);
+            return true;
+        }
+        if (Policy == WEBGUI_KEEP_PREVIOUS) {
+            return false;
+        }
+        if (Policy == WEBGUI_TRUNCATE_ELLIPSIS && Capacity > 3) {
+            memmove(buffer, text, Capacity - 3);
+            memcpy(buffer + Capacity - 3, "...", 3);
+        } else {
+            memmove(buffer, text, Capacity);
+        }
+        setLength(Capacity);
+        return false;
+    }
+
+    void clear() { setLength(0); }
+
+    const char* c_str() const { return buffer; }
+    size_t length() const { return len; }
+    static size_t capacity() { return Capacity; }
+
+    operator String() const { return String(buffer); }
+
+    bool equals(const char* text) const { return strcmp(buffer, text ? text : "") == 0; }
+    bool operator==(const char* text) const { return equals(text); }
+    bool operator==(const String& text) const { return equals(text.c_str()); }
+    bool operator==(const WebGUIFixedString& other) const { return equals(other.buffer); }
+    bool operator!=(const char* text) const { return !equals(text); }
+    bool operator!=(const String& text) const { return !equals(text.c_str()); }
+    bool operator!=(const WebGUIFixedString& other) const { return !equals(other.buffer); }
+
+    int indexOf(const char* text) const {
+        const char* found = strstr(buffer, text);
+        return found ? (int)(found - buffer) : -1;
+    }
+
+  private:
+    char buffer[Capacity + 1];
+    size_t len;
+
+    void setLength(size_t newLength) {
+        len = newLength;
+        buffer[len] = '\0';
+    }
+};
+
+// Storage types for element state. With WEBGUI_INLINE_STRINGS off these are
+// plain Strings, so existing sketches see no difference.
+#if WEBGUI_INLINE_STRINGS
+  typedef WebGUIFixedString<WEBGUI_ID_CAPACITY, WEBGUI_KEEP_PREVIOUS> WebGUIIDString;
+  typedef WebGUIFixedString<WEBGUI_LABEL_CAPACITY, WEBGUI_LABEL_TRUNCATION> WebGUILabelString;
+  typedef WebGUIFixedString<WEBGUI_SENSOR_VALUE_CAPACITY, WEBGUI_SENSOR_VALUE_TRUNCATION> WebGUISensorValueString;
+  typedef WebGUIFixedString<WEBGUI_TEXTBOX_CAPACITY, WEBGUI_TEXTBOX_TRUNCATION> WebGUITextBoxString;
+  typedef WebGUIFixedString<WEBGUI_PLACEHOLDER_CAPACITY, WEBGUI_LABEL_TRUNCATION> WebGUIPlaceholderString;
+  typedef WebGUIFixedString<WEBGUI_BUTTON_STYLE_CAPACITY, WEBGUI_KEEP_PREVIOUS> WebGUIButtonStyleString;
+#else
+  typedef String WebGUIIDString;
+  typedef String WebGUILabelString;
+  typedef String WebGUISensorValueString;
+  typedef String WebGUITextBoxString;
+  typedef String WebGUIPlaceholderString;
+  typedef String WebGUIButtonStyleString;
+#endif
+
+// ============================================================================
+// Borrowed text
+// ============================================================================
+
+#if defined(ESP32)
+  #include "soc/soc.h"
+#endif
+
+// True if text lives in flash, i.e. it is a string literal or other constant
+// that stays valid for the life of the program. All supported boards map
+// flash into the normal address space, so such text can be read in place.
+inline bool webguiIsConstantText(const void* text) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(text);
+#if defined(ESP32)
+    return address >= SOC_DROM_LOW && address < SOC_DROM_HIGH;
+#elif defined(ARDUINO_SAMD_NANO_33_IOT) || defined(ARDUINO_UNOWIFIR4) || defined(ARDUINO_UNOR4_WIFI)
+    return address < 0x20000000;  // Code flash sits below SRAM on SAMD21 and RA4M1
+#else
+    (void)address;
+    return false;
+#endif
+}
+
+// Constructor argument for element text. F() strings and string literals are
+// borrowed; anything else (Strings, char buffers) is copied by the element.
+class WebGUIText {
+  public:
+    WebGUIText(const char* text) : text(text ? text : ""), constant(text && webguiIsConstantText(text)) {}
+    WebGUIText(const __FlashStringHelper* text)
+        : text(reinterpret_cast<const char*>(text)), constant(true) {}
+    WebGUIText(const String& text) : text(text.c_str()), constant(false) {}
+    
+    const char* c_str() const { return text; }
+    bool isConstant() const { return constant; }
+    
+  private:
+    const char* text;
+    bool constant;
+};
+
+// Element text that points at a constant until it is changed at run time,
+// and only then copies into Owned storage
+template <typename Owned>
+class WebGUIConstText {
+  public:
+    WebGUIConstText() : borrowed("") {}
+    WebGUIConstText(const WebGUIText& text) : borrowed(nullptr) { *this = text; }
+    
+    WebGUIConstText& operator=(const WebGUIText& text) {
+        if (text.isConstant()) {
+            borrowed = text.c_str();
+            owned = Owned();  // Give back any copy made earlier
+        } else {
+            owned = text.c_str();
+            borrowed = nullptr;
+        }
+        return *this;
+    }
+    WebGUIConstText& operator=(const String& text) { return *this = WebGUIText(text); }
+    WebGUIConstText& operator=(const char* text) { return *this = WebGUIText(text); }
+    
+    const char* c_str() const { return borrowed ? borrowed : owned.c_str(); }
+    size_t length() const { return strlen(c_str()); }
+    bool isBorrowed() const { return borrowed != nullptr; }
+    
+    operator String() const { return String(c_str()); }
+    
+    int indexOf(const char* text) const {
+        const char* found = strstr(c_str(), text);
+        return found ? (int)(found - c_str()) : -1;
+    }
+    
+  private:
+    const char* borrowed;   // nullptr when the text is in owned
+    Owned owned;
+};
+
+typedef WebGUIConstText<WebGUILabelString> WebGUILabelText;
+typedef WebGUIConstText<WebGUIPlaceholderString> WebGUIPlaceholderText;
+
+#endif
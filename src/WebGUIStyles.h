@@ -11,74 +11,141 @@
 #define WebGUIStyles_h
 
 #include "Arduino.h"
+#include "WebGUIResponse.h"
 
 // MEMORY-OPTIMIZED: Minimal CSS - uses browser defaults to save ~9KB RAM
+// Colors and font come from the --webgui-* variables a theme sets; each
+// var() falls back to the original color, so without a theme block the
+// page looks exactly as it always has
 const char WEBGUI_DEFAULT_CSS[] PROGMEM = R"rawliteral(
-body { margin: 20px; font-family: Arial, sans-serif; }
+body { margin: 20px; font-family: var(--webgui-font, Arial, sans-serif); }
 h1 { margin-bottom: 20px; }
-input[type="range"] { width: 300px; margin: 10px; }
+input[type="range"] { width: 300px; margin: 10px; accent-color: var(--webgui-primary, auto); }
 input[type="text"] { width: 300px; padding: 8px; margin: 5px 0; border: 1px solid #ccc; border-radius: 4px; font-size: 14px; }
-input[type="text"]:focus { border-color: #007bff; outline: none; box-shadow: 0 0 5px rgba(0,123,255,0.5); }
+input[type="text"]:focus { border-color: var(--webgui-primary, #007bff); outline: none; box-shadow: 0 0 5px var(--webgui-focus, rgba(0,123,255,0.5)); }
 button { padding: 10px; margin: 5px; border: 1px solid #ccc; background: #f8f9fa; cursor: pointer; }
 button:hover { background: #e9ecef; }
-.webgui-button-active { background: #007bff; color: white; }
-.webgui-button-inactive { background: #f8f9fa; color: #333; }
+.webgui-button-active { background: var(--webgui-primary, #007bff); color: white; }
+.webgui-button-inactive { background: #f8f9fa; color: var(--webgui-inactive, #333); }
 label { display: block; margin: 10px 0 5px 0; font-weight: bold; }
-.webgui-slider-value { color: #007bff; font-weight: normal; }
+.webgui-slider-value { color: var(--webgui-primary, #007bff); font-weight: normal; }
 .webgui-textbox-container { margin: 15px 0; }
 .webgui-textbox-label { display: block; margin: 10px 0 5px 0; font-weight: bold; }
 .webgui-textbox { width: 100%; padding: 8px; border: 1px solid #ccc; border-radius: 4px; font-size: 14px; }
-.webgui-textbox:focus { border-color: #007bff; outline: none; box-shadow: 0 0 5px rgba(0,123,255,0.5); }
+.webgui-textbox:focus { border-color: var(--webgui-primary, #007bff); outline: none; box-shadow: 0 0 5px var(--webgui-focus, rgba(0,123,255,0.5)); }
 .webgui-sensor-container { margin: 15px 0; }
 .webgui-sensor-label { display: block; margin: 10px 0 5px 0; font-weight: bold; }
-.webgui-sensor-value { color: #007bff; font-weight: bold; font-size: 1.1em; }
+.webgui-sensor-value { color: var(--webgui-primary, #007bff); font-weight: bold; font-size: 1.1em; }
 .webgui-toggle-container { margin: 15px 0; }
 .webgui-toggle-switch { position: relative; display: inline-block; width: 60px; height: 34px; }
 .webgui-toggle-input { opacity: 0; width: 0; height: 0; }
 .webgui-toggle-slider { position: absolute; cursor: pointer; top: 0; left: 0; right: 0; bottom: 0; background: #ccc; transition: 0.4s; border-radius: 34px; }
 .webgui-toggle-slider:before { position: absolute; content: ""; height: 26px; width: 26px; left: 4px; bottom: 4px; background: white; transition: 0.4s; border-radius: 50%; }
-.webgui-toggle-input:checked + .webgui-toggle-slider { background: #2196F3; }
+.webgui-toggle-input:checked + .webgui-toggle-slider { background: var(--webgui-toggle, #2196F3); }
 .webgui-toggle-input:checked + .webgui-toggle-slider:before { transform: translateX(26px); }
 )rawliteral";
 
-// Theme structures (kept for compatibility but not used)
+// Theme colors and font, emitted as CSS variables ahead of the stylesheet.
+// Holds pointers only: pass string literals or other text that stays valid.
+// The defaults are the stylesheet's own colors. A null background or text
+// color leaves the browser's default in place; secondaryColor isn't used
+// by the built-in styles and is there for custom CSS.
 struct WebGUITheme {
     const char* primaryColor;
     const char* secondaryColor;
     const char* backgroundColor;
     const char* textColor;
     const char* fontFamily;
+    const char* toggleColor;     // A toggle switched on
+    const char* inactiveColor;   // Text of a button that isn't active
+    const char* focusColor;      // Glow around a focused text box
     
     WebGUITheme(const char* primary = "#007bff", 
                 const char* secondary = "#6c757d", 
-                const char* background = "#ffffff", 
-                const char* text = "#333333", 
-                const char* font = "Arial, sans-serif") 
+                const char* background = nullptr, 
+                const char* text = nullptr, 
+                const char* font = "Arial, sans-serif",
+                const char* toggle = "#2196F3",
+                const char* inactive = "#333",
+                const char* focus = "rgba(0,123,255,0.5)") 
         : primaryColor(primary), secondaryColor(secondary), 
-          backgroundColor(background), textColor(text), fontFamily(font) {}
+          backgroundColor(background), textColor(text), fontFamily(font),
+          toggleColor(toggle), inactiveColor(inactive), focusColor(focus) {}
 };
 
 const WebGUITheme WEBGUI_DEFAULT_THEME;
 
-// Simplified style manager class
 class WebGUIStyleManager {
   public:
+    // True if the theme changes nothing, so no theme block is needed
+    static bool isDefaultTheme(const WebGUITheme& theme) {
+        const WebGUITheme& d = WEBGUI_DEFAULT_THEME;
+        return sameText(theme.primaryColor, d.primaryColor) && sameText(theme.secondaryColor, d.secondaryColor) &&
+               sameText(theme.backgroundColor, d.backgroundColor) && sameText(theme.textColor, d.textColor) &&
+               sameText(theme.fontFamily, d.fontFamily) && sameText(theme.toggleColor, d.toggleColor) &&
+               sameText(theme.inactiveColor, d.inactiveColor) && sameText(theme.focusColor, d.focusColor);
+    }
+    
+    // The :root block that sets the --webgui-* variables for a theme, and a
+    // body rule if it sets a background or text color
+    static void streamThemeCSS(Print& out, const WebGUITheme& theme) {
+        out.print(":root{");
+        streamVariable(out, "--webgui-primary", theme.primaryColor);
+        streamVariable(out, "--webgui-secondary", theme.secondaryColor);
+        streamVariable(out, "--webgui-background", theme.backgroundColor);
+        streamVariable(out, "--webgui-text", theme.textColor);
+        streamVariable(out, "--webgui-font", theme.fontFamily);
+        streamVariable(out, "--webgui-toggle", theme.toggleColor);
+        streamVariable(out, "--webgui-inactive", theme.inactiveColor);
+        streamVariable(out, "--webgui-focus", theme.focusColor);
+        out.print("}");
+        if (theme.backgroundColor || theme.textColor) {
+            out.print("body{");
+            streamVariable(out, "background", theme.backgroundColor);
+            streamVariable(out, "color", theme.textColor);
+            out.print("}");
+        }
+    }
+    
+    // Theme block (unless the theme is the default) plus the default
+    // stylesheet, streamed straight from flash
+    static void streamCSS(Print& out, const WebGUITheme& theme = WEBGUI_DEFAULT_THEME) {
+        if (!isDefaultTheme(theme)) {
+            streamThemeCSS(out, theme);
+        }
+        out.print(WEBGUI_DEFAULT_CSS);
+    }
+    
+    // String versions, kept for compatibility; these copy the stylesheet into RAM
     static String getDefaultCSS() {
-        return String(WEBGUI_DEFAULT_CSS);
+        return getThemedCSS(WEBGUI_DEFAULT_THEME);
     }
     
     static String getThemedCSS(const WebGUITheme& theme) {
-        // Memory optimized: just return default CSS regardless of theme
-        return getDefaultCSS();
+        String css;
+        css.reserve(strlen_P(WEBGUI_DEFAULT_CSS) + 160);
+        WebGUIStringPrint out(css);
+        streamCSS(out, theme);
+        return css;
     }
     
     static String generateCustomCSS(const char* customCSS) {
-        // Memory optimized: combine minimal default with custom
         return getDefaultCSS() + String(customCSS);
     }
     
   private:
-    // No complex theme replacement needed
+    static bool sameText(const char* a, const char* b) {
+        return a == b || (a && b && strcmp(a, b) == 0);
+    }
+    
+    static void streamVariable(Print& out, const char* name, const char* value) {
+        if (value) {
+            out.print(name);
+            out.print(':');
+            out.print(value);
+            out.print(';');
+        }
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+/*
+  WebGUITrace.cpp - Ring buffer of recent requests for the WebGUI Library
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#include "WebGUITrace.h"
+#include "WebGUIFormat.h"
+
+#if WEBGUI_TRACE_SIZE > 0
+
+void WebGUITrace::dump(Print& out) const {
+    out.print("# now_ms ");
+    out.println(millis());
+    out.println("# start_ms client          route    status  parse_us handle_us send_us bytes_in bytes_out");
+    for (size_t i = 0; i < count; i++) {
+        const WebGUITraceEntry& e = get(i);
+        webguiPrintRight(out, e.startMillis, 10);
+        out.print(' ');
+        
+        // Printed octet by octet: IPAddress::toString() would allocate
+        uint8_t ipLength = 0;
+        for (int b = 0; b < 4; b++) {
+            if (b > 0) {
+                out.print('.');
+                ipLength++;
+            }
+            out.print((unsigned int)e.clientIP[b]);
+            ipLength += e.clientIP[b] >= 100 ? 3 : (e.clientIP[b] >= 10 ? 2 : 1);
+        }
+        for (uint8_t pad = ipLength; pad < 16; pad++) {
+            out.print(' ');
+        }
+        
+        webguiPrintLeft(out, webguiRouteName(e.route), 8);
+        webguiPrintRight(out, e.status, 6);
+        webguiPrintRight(out, e.parseMicros, 10);
+        webguiPrintRight(out, e.handleMicros, 10);
+        webguiPrintRight(out, e.sendMicros, 8);
+        webguiPrintRight(out, e.bytesIn, 9);
+        webguiPrintRight(out, e.bytesOut, 10);
+        out.println();
+    }
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+  WebGUITrace.h - Ring buffer of recent requests for the WebGUI Library
+
+  Keeps the last WEBGUI_TRACE_SIZE requests with their timings so a stall
+  reported after the fact ("it froze for a second") can be looked up at
+  /debug/trace or dumped over Serial. Recording copies one fixed-size entry;
+  all formatting happens when the trace is read.
+
+  Copyright (c) 2025 WebGUI Library Contributors
+*/
+
+#ifndef WebGUITrace_h
+#define WebGUITrace_h
+
+#include "Arduino.h"
+#include "WebGUIConfig.h"
+#include "WebGUIMetrics.h"
+
+struct WebGUITraceEntry {
+    uint32_t startMillis;    // millis() when the connection was accepted
+    uint32_t parseMicros;    // Reading the request (0 on ESP32: WebServer parses it)
+    uint32_t handleMicros;   // Building the response
+    uint32_t sendMicros;     // Writing to the client and closing it
+    uint32_t bytesOut;
+    uint16_t bytesIn;
+    uint16_t status;         // HTTP status; 0 if closed without a response
+    uint8_t clientIP[4];
+    uint8_t route;           // WebGUIRoute
+};
+
+#if WEBGUI_TRACE_SIZE > 0
+
+class WebGUITrace {
+  public:
+    WebGUITrace() : next(0), count(0) {}
+
+    void record(const WebGUITraceEntry& entry) {
+        entries[next] = entry;
+        next = (next + 1) % WEBGUI_TRACE_SIZE;
+        if (count < WEBGUI_TRACE_SIZE) count++;
+    }
+
+    size_t size() const { return count; }
+
+    // 0 is the oldest entry still held
+    const WebGUITraceEntry& get(size_t index) const {
+        return entries[(next + WEBGUI_TRACE_SIZE - count + index) % WEBGUI_TRACE_SIZE];
+    }
+
+    void clear() { next = 0; count = 0; }
+
+    // One line per request, oldest first
+    void dump(Print& out) const;
+
+  private:
+    WebGUITraceEntry entries[WEBGUI_TRACE_SIZE];
+    size_t next;
+    size_t count;
+};
+
+#else
+
+class WebGUITrace {
+  public:
+    void record(const WebGUITraceEntry&) {}
+    size_t size() const { return 0; }
+    void clear() {}
+    void dump(Print&) const {}
+};
+
+#endif
+
+#endif